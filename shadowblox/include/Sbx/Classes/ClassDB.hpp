@@ -15,6 +15,7 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -35,6 +36,7 @@
 #include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/Binder.hpp"
 #include "Sbx/Runtime/ClassBinder.hpp"
+#include "Sbx/Runtime/SignalEmitter.hpp"
 #include "Sbx/Runtime/Stack.hpp"
 #include "Sbx/Runtime/StringMap.hpp"
 
@@ -132,6 +134,7 @@ public:
 	struct Property {
 		std::string name;
 		std::string changedSignal;
+		int changedSignalId = -1;
 		std::string category;
 		std::any (*getter)(void *self) = nullptr;
 		bool (*setter)(void *self, const std::any &value) = nullptr;
@@ -146,6 +149,7 @@ public:
 
 	struct Signal {
 		std::string name;
+		int id = -1;
 		std::vector<Parameter> parameters;
 		std::unordered_set<MemberTag> tags;
 		SbxCapability security = NoneSecurity;
@@ -165,6 +169,7 @@ public:
 	struct ClassInfo {
 		std::string name;
 		std::string parent;
+		int id = -1;
 		MemoryCategory category;
 		std::unordered_set<ClassTag> tags;
 
@@ -218,27 +223,34 @@ public:
 	};
 
 	template <typename T, MemoryCategory category, ClassTag... tags>
-	static void AddClass(const char *parent) {
+	static int AddClass(const char *parent) {
 		ClassInfo info;
 		info.name = T::NAME;
 		info.parent = parent;
+		info.id = static_cast<int>(classRanges.size());
 		info.category = category;
 		info.tags = { tags... };
 
+		const int id = info.id;
 		classes[T::NAME] = std::move(info);
+		classRanges.emplace_back();
+		UpdateClassRanges();
+
 		if constexpr (((tags != ClassTag::NotCreatable) && ...)) {
 			constructors[T::NAME] = []() -> std::shared_ptr<Object> {
 				return std::make_shared<T>();
 			};
 		}
 		registerCallbacks.push_back(LuauClassBinder<T>::InitMetatable);
+		return id;
 	}
 
 	template <typename T, StringLiteral name, auto F, SbxCapability capability, ThreadSafety safety, typename... Args>
 	static void BindMethod(std::unordered_set<MemberTag> tags, Args... paramNames) {
 		classes[T::NAME].functions[name.value] = CreateFunction<decltype(F)>(
 				name.value, capability, safety, std::move(tags), paramNames...);
-		LuauClassBinder<T>::template BindMethod<name, F, capability>();
+		LuauClassBinder<T>::template BindLuauMethod<name,
+				GuardIf<T, name, BindFunction, luaSBX_bindcxx<name, F, capability>, safety == ThreadSafety::Unsafe>()>();
 	}
 
 	template <typename T, StringLiteral name, typename Sig, lua_CFunction F, SbxCapability capability, ThreadSafety safety, typename... Args>
@@ -246,7 +258,8 @@ public:
 		tags.insert(MemberTag::CustomLuaState);
 		classes[T::NAME].functions[name.value] = CreateFunction<Sig>(
 				name.value, capability, safety, std::move(tags), paramNames...);
-		LuauClassBinder<T>::template BindLuauMethod<name, F>();
+		LuauClassBinder<T>::template BindLuauMethod<name,
+				GuardIf<T, name, BindFunction, F, safety == ThreadSafety::Unsafe>()>();
 	}
 
 	template <typename T, StringLiteral name, StringLiteral category, auto G, SbxCapability getCapability, auto S, SbxCapability setCapability, ThreadSafety safety, bool canLoad, bool canSave>
@@ -255,7 +268,10 @@ public:
 				name.value, category.value, getCapability, setCapability, safety, canLoad, canSave, std::move(tags));
 		classes[T::NAME].signals[std::string(name.value) + "Changed"] = CreateSignal<void()>(
 				std::string(name.value) + "Changed", getCapability, {}, true);
-		LuauClassBinder<T>::template BindProperty<name, G, getCapability, S, setCapability>();
+		LuauClassBinder<T>::template BindLuauProperty<name,
+				GuardIf<T, name, BindGetter, luaSBX_bindcxx<name, G, getCapability, BindGetter>, safety == ThreadSafety::Unsafe>(),
+				GuardIf<T, name, BindSetter, luaSBX_bindcxx<name, S, setCapability, BindSetter>, safety != ThreadSafety::Safe>()>();
+		LuauClassBinder<T>::template BindSignal<name + "Changed", SignalGetter<T, name + "Changed", getCapability>>();
 	}
 
 	template <typename T, StringLiteral name, StringLiteral category, auto G, SbxCapability getCapability, ThreadSafety safety, bool canSave>
@@ -265,7 +281,9 @@ public:
 				name.value, category.value, getCapability, NoneSecurity, safety, false, canSave, std::move(tags));
 		classes[T::NAME].signals[std::string(name.value) + "Changed"] = CreateSignal<void()>(
 				std::string(name.value) + "Changed", getCapability, {}, true);
-		LuauClassBinder<T>::template BindPropertyReadOnly<name, G, getCapability>();
+		LuauClassBinder<T>::template BindLuauProperty<name,
+				GuardIf<T, name, BindGetter, luaSBX_bindcxx<name, G, getCapability, BindGetter>, safety == ThreadSafety::Unsafe>()>();
+		LuauClassBinder<T>::template BindSignal<name + "Changed", SignalGetter<T, name + "Changed", getCapability>>();
 	}
 
 	template <typename T, StringLiteral name, StringLiteral category, auto G, auto S, ThreadSafety safety, bool canLoad, bool canSave>
@@ -283,10 +301,25 @@ public:
 				name.value, category.value, NoneSecurity, NoneSecurity, safety, false, canSave, std::move(tags));
 	}
 
+	// Custom Luau accessors of a property bound with one of the
+	// NotScriptable variants, guarded by the same thread safety
+	template <typename T, StringLiteral name, lua_CFunction G, lua_CFunction S, ThreadSafety safety>
+	static void BindLuauProperty() {
+		if constexpr (S == nullptr) {
+			LuauClassBinder<T>::template BindLuauProperty<name,
+					GuardIf<T, name, BindGetter, G, safety == ThreadSafety::Unsafe>()>();
+		} else {
+			LuauClassBinder<T>::template BindLuauProperty<name,
+					GuardIf<T, name, BindGetter, G, safety == ThreadSafety::Unsafe>(),
+					GuardIf<T, name, BindSetter, S, safety != ThreadSafety::Safe>()>();
+		}
+	}
+
 	template <typename T, StringLiteral name, typename Sig, SbxCapability capability, typename... Args>
 	static void BindSignal(std::unordered_set<MemberTag> tags, Args... paramNames) {
 		classes[T::NAME].signals[name.value] = CreateSignal<Sig>(
 				name.value, capability, std::move(tags), false, paramNames...);
+		LuauClassBinder<T>::template BindSignal<name, SignalGetter<T, name, capability>>();
 	}
 
 	template <typename T, StringLiteral name, typename Sig, void (T::*F)(lua_State *), SbxCapability capability, ThreadSafety safety, typename... Args>
@@ -303,6 +336,8 @@ public:
 		cb.safety = safety;
 
 		classes[T::NAME].callbacks[name.value] = std::move(cb);
+		LuauClassBinder<T>::template BindCallback<name,
+				GuardIf<T, name, BindSetter, CallbackSetter<T, F>, safety == ThreadSafety::Unsafe>()>();
 	}
 
 	static const ClassInfo *GetClass(std::string_view className);
@@ -311,12 +346,98 @@ public:
 	static const Signal *GetSignal(std::string_view className, std::string_view sigName);
 	static const Callback *GetCallback(std::string_view className, std::string_view cbName);
 
+	static int GetClassId(std::string_view className);
+
 	static std::shared_ptr<Object> New(std::string_view className);
 	static bool IsA(std::string_view derived, std::string_view base);
 
+	/**
+	 * @brief Check whether one class derives from (or is) another, by ID.
+	 *
+	 * @param derived The ID of the derived class.
+	 * @param base    The ID of the base class.
+	 * @return Whether `derived` is `base` or one of its descendants. If either
+	 *         ID is invalid, returns `false`.
+	 */
+	static bool IsA(int derived, int base) {
+		if (derived < 0 || base < 0) {
+			return false;
+		}
+
+		const ClassRange &d = classRanges[derived];
+		const ClassRange &b = classRanges[base];
+		return b.first <= d.first && d.first <= b.last;
+	}
+
 	static void Register(lua_State *L);
 
+	/**
+	 * @brief Stop registering classes.
+	 *
+	 * Class information is read without locking, so hosts running VMs on
+	 * several threads must freeze it once all classes are initialized.
+	 * Classes initialized afterwards are not registered, and are reported by
+	 * @ref ReportFrozenClass.
+	 *
+	 * Calls are counted, so it stays frozen until each is matched by
+	 * @ref Unfreeze.
+	 */
+	static void Freeze() { freezeCount++; }
+	static void Unfreeze() { freezeCount--; }
+	static bool IsFrozen() { return freezeCount > 0; }
+
+	// Reports a class which was first initialized while frozen. Its instances
+	// would have no class ID, so this is a bug in the host.
+	static void ReportFrozenClass(const char *className);
+
 private:
+	// Position of a class in a pre-order traversal of the class tree, and the
+	// last position occupied by its descendants
+	struct ClassRange {
+		int first = 0;
+		int last = -1;
+	};
+
+	static void UpdateClassRanges();
+
+	template <typename T, StringLiteral name, SbxCapability capability>
+	static int SignalGetter(lua_State *L) {
+		T *self = LuauStackOp<T *>::Check(L, 1);
+		// Resolved once, on first access
+		static const int signal = SignalEmitter::GetSignalId(name.value);
+		self->PushSignal(L, 1, signal, capability);
+		return 1;
+	}
+
+	// Members which are not thread safe raise an error when used by a
+	// desynchronized thread
+	template <typename T, StringLiteral name, BindPurpose purpose, lua_CFunction F>
+	static int SerialOnly(lua_State *L) {
+		static const char *ACTIONS[] = { "call", "read", "write" };
+		static const std::string target = std::string(T::NAME) + '.' + name.value;
+		luaSBX_checkserial(L, ACTIONS[purpose], target.c_str());
+		return F(L);
+	}
+
+	template <typename T, StringLiteral name, BindPurpose purpose, lua_CFunction F, bool serialOnly>
+	static constexpr lua_CFunction GuardIf() {
+		if constexpr (serialOnly) {
+			return SerialOnly<T, name, purpose, F>;
+		} else {
+			return F;
+		}
+	}
+
+	template <typename T, void (T::*F)(lua_State *)>
+	static int CallbackSetter(lua_State *L) {
+		T *self = LuauStackOp<T *>::Check(L, 1);
+
+		// Roblox may not perform type checking (e.g., for OnInvoke)
+		lua_remove(L, 1);
+		(self->*F)(L);
+		return 0;
+	}
+
 	template <typename Sig, typename... Args>
 	static Function CreateFunction(const char *name, SbxCapability capability, ThreadSafety safety, std::unordered_set<MemberTag> tags, Args... paramNames) {
 		Function func;
@@ -339,6 +460,7 @@ private:
 		prop.name = name;
 		if (!tags.contains(MemberTag::NotScriptable)) {
 			prop.changedSignal = prop.name + "Changed";
+			prop.changedSignalId = SignalEmitter::GetSignalId(prop.changedSignal);
 		}
 		prop.category = category;
 		prop.getter = [](void *self) -> std::any {
@@ -347,7 +469,15 @@ private:
 		if constexpr (!std::is_same_v<decltype(S), std::nullptr_t>) {
 			prop.setter = [](void *self, const std::any &value) -> bool {
 				if (value.type() == typeid(BaseType)) {
-					(((T *)self)->*S)(std::any_cast<BaseType>(value));
+					if constexpr (std::is_same_v<BaseType, const char *>) {
+						// Setters may take a string_view, which cannot be
+						// made from null
+						const char *str = std::any_cast<const char *>(value);
+						(((T *)self)->*S)(str ? str : "");
+					} else {
+						(((T *)self)->*S)(std::any_cast<BaseType>(value));
+					}
+
 					return true;
 				}
 
@@ -376,6 +506,7 @@ private:
 	static Signal CreateSignal(std::string_view name, SbxCapability capability, std::unordered_set<MemberTag> tags, bool unlisted, Args... paramNames) {
 		Signal signal;
 		signal.name = name;
+		signal.id = SignalEmitter::GetSignalId(name);
 		signal.parameters = FuncUtils<Sig>::GetParams(paramNames...);
 		signal.tags = std::move(tags);
 		signal.security = capability;
@@ -385,8 +516,10 @@ private:
 	}
 
 	static StringMap<ClassInfo> classes;
+	static std::vector<ClassRange> classRanges; // By class ID
 	static StringMap<std::shared_ptr<Object> (*)()> constructors;
 	static std::vector<void (*)(lua_State *)> registerCallbacks;
+	static std::atomic<int> freezeCount;
 };
 
 #define SBXCLASS(className, parent, category, ...)                                                                    \
@@ -397,50 +530,21 @@ public:
 	className &operator=(className &&other) = delete;                                                                 \
                                                                                                                       \
 	static constexpr const char *NAME = #className;                                                                   \
+	static inline int CLASS_ID = -1;                                                                                  \
                                                                                                                       \
 	const char *GetClassName() const override { return NAME; }                                                        \
+	int GetClassId() const override { return CLASS_ID; }                                                              \
                                                                                                                       \
 	static void InitializeClass() {                                                                                   \
 		static bool initialized = false;                                                                              \
-		if (!initialized) {                                                                                           \
-			::SBX::Classes::ClassDB::AddClass<className, category, ##__VA_ARGS__>(#parent);                           \
-			LuauClassBinder<className>::Init(#className, #className, -1, ::SBX::Classes::Variant::Object);            \
-			LuauClassBinder<className>::AddIndexOverride(IndexOverride);                                              \
-			LuauClassBinder<className>::AddNewindexOverride(NewindexOverride);                                        \
+		if (!initialized && ::SBX::Classes::ClassDB::IsFrozen()) {                                                    \
+			::SBX::Classes::ClassDB::ReportFrozenClass(#className);                                                   \
+		} else if (!initialized) {                                                                                    \
+			CLASS_ID = ::SBX::Classes::ClassDB::AddClass<className, category, ##__VA_ARGS__>(#parent);                \
+			LuauClassBinder<className>::Init(#className, #className, -1, ::SBX::Classes::Variant::Object, CLASS_ID);  \
 			BindMembers<className>();                                                                                 \
 			initialized = true;                                                                                       \
 		}                                                                                                             \
-	}                                                                                                                 \
-                                                                                                                      \
-private:                                                                                                              \
-	static int IndexOverride(lua_State *L, const char *propName) {                                                    \
-		className *self = ::SBX::LuauStackOp<className *>::Check(L, 1);                                               \
-                                                                                                                      \
-		if (const ClassDB::Signal *sig = ClassDB::GetSignal(className::NAME, propName)) {                             \
-			self->PushSignal(L, sig->name, sig->security);                                                            \
-			return 1;                                                                                                 \
-		}                                                                                                             \
-                                                                                                                      \
-		if (ClassDB::GetCallback(className::NAME, propName)) {                                                        \
-			luaL_error(L, "%s is a callback member of %s; you can only set the callback value, get is not available", \
-					propName, className::NAME);                                                                       \
-		}                                                                                                             \
-                                                                                                                      \
-		return 0;                                                                                                     \
-	}                                                                                                                 \
-                                                                                                                      \
-	static bool NewindexOverride(lua_State *L, const char *propName) {                                                \
-		className *self = ::SBX::LuauStackOp<className *>::Check(L, 1);                                               \
-                                                                                                                      \
-		if (const ClassDB::Callback *cb = ClassDB::GetCallback(className::NAME, propName)) {                          \
-			/* Roblox may not perform type checking (e.g., for OnInvoke) */                                           \
-			lua_remove(L, 2); /* name */                                                                              \
-			lua_remove(L, 1); /* self */                                                                              \
-			cb->func(self, L);                                                                                        \
-			return true;                                                                                              \
-		}                                                                                                             \
-                                                                                                                      \
-		return false;                                                                                                 \
 	}
 
 } //namespace SBX::Classes
@@ -90,7 +90,7 @@ protected:
 				&T::FindServiceLuau, NoneSecurity, ThreadSafety::Safe>({}, "className");
 
 		// Workspace property - accessor to Workspace service
-		LuauClassBinder<T>::AddIndexOverride(WorkspaceIndexOverride);
+		LuauClassBinder<T>::template BindLuauProperty<"Workspace", &DataModel::GetWorkspaceLuau>();
 	}
 
 private:
@@ -102,8 +102,8 @@ private:
 	std::unordered_map<std::string, std::shared_ptr<Instance>> services;
 	std::weak_ptr<Workspace> workspace;
 
-	// Custom index override for Workspace property
-	static int WorkspaceIndexOverride(lua_State *L, const char *propName);
+	// Custom Luau accessor for Workspace property
+	static int GetWorkspaceLuau(lua_State *L);
 };
 
 } // namespace SBX::Classes
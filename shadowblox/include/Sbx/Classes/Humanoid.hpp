@@ -89,8 +89,8 @@ protected:
 	static void BindMembers() {
 		Instance::BindMembers<T>();
 
-		// Vector3 properties via custom index
-		LuauClassBinder<T>::AddIndexOverride(HumanoidIndexOverride);
+		// Vector3 properties via custom Luau accessors
+		LuauClassBinder<T>::template BindLuauProperty<"MoveDirection", &Humanoid::GetMoveDirectionLuau>();
 
 		// Register MoveDirection for reflection
 		ClassDB::BindPropertyNotScriptable<T, "MoveDirection", "Humanoid",
@@ -148,9 +148,6 @@ private:
 	bool platformStand = false;
 	bool autoRotate = true;
 	DataTypes::Vector3 moveDirection = DataTypes::Vector3::zero;
-
-	// Custom index override for Vector3 properties
-	static int HumanoidIndexOverride(lua_State *L, const char *propName);
 };
 
 } // namespace SBX::Classes
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "lua.h"
@@ -41,7 +42,7 @@ public:
 
 	// Properties
 	const char *GetName() const;
-	void SetName(const char *newName);
+	void SetName(std::string_view newName);
 
 	std::shared_ptr<Instance> GetParent() const;
 	void SetParent(std::shared_ptr<Instance> newParent);
@@ -49,9 +50,9 @@ public:
 	// Methods
 	std::vector<std::shared_ptr<Instance>> GetChildren() const;
 	std::vector<std::shared_ptr<Instance>> GetDescendants() const;
-	std::shared_ptr<Instance> FindFirstChild(const char *name, bool recursive = false) const;
+	std::shared_ptr<Instance> FindFirstChild(std::string_view name, bool recursive = false) const;
 	std::shared_ptr<Instance> FindFirstChildOfClass(const char *className, bool recursive = false) const;
-	std::shared_ptr<Instance> FindFirstAncestor(const char *name) const;
+	std::shared_ptr<Instance> FindFirstAncestor(std::string_view name) const;
 	std::shared_ptr<Instance> FindFirstAncestorOfClass(const char *className) const;
 	std::shared_ptr<Instance> FindFirstAncestorWhichIsA(const char *className) const;
 	std::shared_ptr<Instance> FindFirstChildWhichIsA(const char *className, bool recursive = false) const;
@@ -99,7 +100,7 @@ protected:
 		ClassDB::BindProperty<T, "Name", "Data", &Instance::GetName, NoneSecurity,
 				&Instance::SetName, NoneSecurity, ThreadSafety::Unsafe, true, true>({});
 
-		// Parent is handled via index/newindex overrides
+		// Parent is bound below with custom accessors
 
 		// Methods
 		ClassDB::BindLuauMethod<T, "GetChildren", std::vector<std::shared_ptr<Instance>>(),
@@ -151,11 +152,10 @@ protected:
 		// Register Parent property in ClassDB for reflection (not scriptable via normal path)
 		ClassDB::BindPropertyNotScriptable<T, "Parent", "Data",
 				&Instance::GetParent, &Instance::SetParent,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 
-		// Add custom index/newindex overrides for Parent property
-		LuauClassBinder<T>::AddIndexOverride(ParentIndexOverride);
-		LuauClassBinder<T>::AddNewindexOverride(ParentNewindexOverride);
+		// Custom Luau accessors for Parent property
+		ClassDB::BindLuauProperty<T, "Parent", &Instance::GetParentLuau, &Instance::SetParentLuau, ThreadSafety::ReadSafe>();
 	}
 
 private:
@@ -165,9 +165,9 @@ private:
 	std::weak_ptr<Instance> selfWeak;
 	bool destroyed = false;
 
-	// Custom index/newindex overrides for Parent property
-	static int ParentIndexOverride(lua_State *L, const char *propName);
-	static bool ParentNewindexOverride(lua_State *L, const char *propName);
+	// Custom Luau accessors for Parent property
+	static int GetParentLuau(lua_State *L);
+	static int SetParentLuau(lua_State *L);
 
 	// Helper to emit descendant signals up the tree
 	void EmitDescendantAdded(std::shared_ptr<Instance> descendant);
@@ -176,6 +176,9 @@ private:
 
 	// Helper to collect descendants recursively
 	void CollectDescendants(std::vector<std::shared_ptr<Instance>> &result) const;
+
+	// Helper for FindFirstChildWhichIsA with a resolved class ID
+	std::shared_ptr<Instance> FindFirstChildWhichIsAById(int classId, bool recursive) const;
 };
 
 } //namespace SBX::Classes
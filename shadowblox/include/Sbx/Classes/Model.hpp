@@ -68,14 +68,13 @@ protected:
 	static void BindMembers() {
 		Instance::BindMembers<T>();
 
-		// PrimaryPart via custom index/newindex
-		LuauClassBinder<T>::AddIndexOverride(ModelIndexOverride);
-		LuauClassBinder<T>::AddNewindexOverride(ModelNewindexOverride);
+		// PrimaryPart via custom Luau accessors
+		ClassDB::BindLuauProperty<T, "PrimaryPart", &Model::GetPrimaryPartLuau, &Model::SetPrimaryPartLuau, ThreadSafety::ReadSafe>();
 
 		// Register PrimaryPart in ClassDB for reflection
 		ClassDB::BindPropertyNotScriptable<T, "PrimaryPart", "Data",
 				&Model::GetPrimaryPart, &Model::SetPrimaryPart,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 
 		// Methods
 		ClassDB::BindLuauMethod<T, "GetExtentsSize", DataTypes::Vector3(),
@@ -93,10 +92,6 @@ private:
 
 	// Helper to collect all Part descendants
 	void CollectParts(std::vector<Part *> &parts) const;
-
-	// Custom index/newindex overrides for PrimaryPart property
-	static int ModelIndexOverride(lua_State *L, const char *propName);
-	static bool ModelNewindexOverride(lua_State *L, const char *propName);
 };
 
 } //namespace SBX::Classes
@@ -32,16 +32,19 @@
 // clang-format on
 /* BEGIN USER CODE PreNamespace */
 #include <any>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "lualib.h"
 
 #include "Sbx/Runtime/SignalEmitter.hpp"
 #include "Sbx/Runtime/Stack.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
 
 namespace SBX {
 
@@ -52,6 +55,40 @@ class Object;
 template <typename T>
 concept IsObject = std::is_base_of<Object, T>::value;
 
+/**
+ * @brief The userdata representation of all objects, tagged with
+ * `ObjectUdata`.
+ */
+struct ObjectUserdata {
+	std::shared_ptr<Object> object;
+	int classId = -1;
+};
+
+/**
+ * @brief Push a new userdata for an object, without checking the registry.
+ *
+ * @param L      The Luau state.
+ * @param object The object. Must not be null.
+ */
+void luaSBX_newobject(lua_State *L, const std::shared_ptr<Object> &object);
+
+/**
+ * @brief Push the userdata for an object, reusing the existing one for this
+ * VM if it is still alive.
+ *
+ * Each object caches a slot in the weak object registry per VM, so repeated
+ * pushes only require an array lookup.
+ *
+ * @param L      The Luau state.
+ * @param object The object. Must not be null.
+ */
+void luaSBX_pushobject(lua_State *L, const std::shared_ptr<Object> &object);
+
+/**
+ * @brief The destructor for `ObjectUdata` userdata.
+ */
+void luaSBX_objectdtor(lua_State *L, void *udata);
+
 }; //namespace Classes
 
 template <typename T>
@@ -59,55 +96,43 @@ requires Classes::IsObject<T> struct LuauStackOp<std::shared_ptr<T>> {
 	using Ref = std::shared_ptr<T>;
 	static const std::string NAME;
 
-	static void PushRaw(lua_State *L, void * /* unused */, void *userdata) {
-		Ref *udata = reinterpret_cast<Ref *>(lua_newuserdatadtor(L, sizeof(Ref), [](void *udata) {
-			reinterpret_cast<Ref *>(udata)->~Ref();
-		}));
-		new (udata) Ref();
-		*udata = *reinterpret_cast<const Ref *>(userdata);
-
-		luaL_getmetatable(L, (*udata)->GetClassName());
-		if (lua_isnil(L, -1)) {
-			luaL_error(L, "metatable for object %s missing", (*udata)->GetClassName());
-		}
-
-		lua_setmetatable(L, -2);
-	}
-
 	static void Push(lua_State *L, const Ref &value) {
 		if (value) {
-			luaSBX_pushregistry(L, value.get(), (void *)&value, PushRaw, true);
+			Classes::luaSBX_pushobject(L, value);
 		} else {
 			lua_pushnil(L);
 		}
 	}
 
-	static Ref *GetPtr(lua_State *L, int index) {
-		if (!Is(L, index)) {
+	static Classes::ObjectUserdata *GetUdata(lua_State *L, int index) {
+		auto *udata = reinterpret_cast<Classes::ObjectUserdata *>(lua_touserdatatagged(L, index, ObjectUdata));
+		if (!udata || !Classes::ClassDB::IsA(udata->classId, T::CLASS_ID)) {
 			return nullptr;
 		}
 
-		return reinterpret_cast<Ref *>(lua_touserdata(L, index));
+		return udata;
 	}
 
 	static Ref Get(lua_State *L, int index) {
-		return *GetPtr(L, index);
+		Classes::ObjectUserdata *udata = GetUdata(L, index);
+		return udata ? std::static_pointer_cast<T>(udata->object) : nullptr;
 	}
 
 	static bool Is(lua_State *L, int index) {
-		return Classes::ClassDB::IsA(luaL_typename(L, index), T::NAME);
+		return GetUdata(L, index) != nullptr;
 	}
 
-	static Ref *CheckPtr(lua_State *L, int index) {
-		if (!Is(L, index)) {
+	static Classes::ObjectUserdata *CheckUdata(lua_State *L, int index) {
+		Classes::ObjectUserdata *udata = GetUdata(L, index);
+		if (!udata) {
 			luaL_typeerrorL(L, index, T::NAME);
 		}
 
-		return reinterpret_cast<Ref *>(lua_touserdata(L, index));
+		return udata;
 	}
 
 	static Ref Check(lua_State *L, int index) {
-		return *CheckPtr(L, index);
+		return std::static_pointer_cast<T>(CheckUdata(L, index)->object);
 	}
 };
 
@@ -121,8 +146,8 @@ requires Classes::IsObject<T> struct LuauStackOp<T *> {
 	// No implementation of Push.
 
 	static T *Get(lua_State *L, int index) {
-		auto ptr = LuauStackOp<std::shared_ptr<T>>::GetPtr(L, index);
-		return ptr ? ptr->get() : nullptr;
+		Classes::ObjectUserdata *udata = LuauStackOp<std::shared_ptr<T>>::GetUdata(L, index);
+		return udata ? static_cast<T *>(udata->object.get()) : nullptr;
 	}
 
 	static bool Is(lua_State *L, int index) {
@@ -130,7 +155,7 @@ requires Classes::IsObject<T> struct LuauStackOp<T *> {
 	}
 
 	static T *Check(lua_State *L, int index) {
-		return LuauStackOp<std::shared_ptr<T>>::CheckPtr(L, index)->get();
+		return static_cast<T *>(LuauStackOp<std::shared_ptr<T>>::CheckUdata(L, index)->object.get());
 	}
 };
 
@@ -156,6 +181,7 @@ public:
 	ObjectBase &operator=(ObjectBase &&) = default;
 
 	virtual const char *GetClassName() const = 0;
+	virtual int GetClassId() const = 0;
 };
 /* END USER CODE PreClass */
 // clang-format off
@@ -222,25 +248,85 @@ public:
 		return false;
 	}
 
+	// Whether a signal of this object has been pushed to Luau
+	bool HasSignalEmitter() const { return emitter != nullptr; }
+	int NumConnections() const { return emitter ? emitter->NumConnections() : 0; }
+
 protected:
+	friend class ClassDB;
+
 	Object();
 
-	void PushSignal(lua_State *L, std::string_view name, SbxCapability security);
+	/**
+	 * @brief Push a signal of this object, reusing the signal object from
+	 * previous accesses in this VM if it is still alive.
+	 *
+	 * @param L The Luau state.
+	 * @param objIndex The stack index of this object's userdata.
+	 * @param signal The ID of the signal.
+	 * @param security The capability required to connect to the signal.
+	 */
+	void PushSignal(lua_State *L, int objIndex, int signal, SbxCapability security);
+
+	// Signal ID for a name, resolved once per name
+	template <StringLiteral signal>
+	static inline const int signalId = SignalEmitter::GetSignalId(signal.value);
+
+	template <typename T, StringLiteral signal, typename... Args>
+	void Emit(Args... args) {
+		Emit<T>(signalId<signal>, args...);
+	}
 
 	template <typename T, typename... Args>
-	void Emit(std::string_view signal, Args... args) {
+	void Emit(int signal, Args... args) {
+		// Handlers belong to VMs which other workers may be running, so
+		// signals fired in the parallel phase are emitted once it ends
+		if (TaskScheduler *scheduler = TaskScheduler::GetParallelScheduler()) {
+			std::shared_ptr<SignalEmitter> signalEmitter;
+			{
+				LuauLock lock(*this);
+				signalEmitter = emitter;
+			}
+
+			if (signalEmitter) {
+				scheduler->DeferSerial([signalEmitter, signal, args...]() {
+					signalEmitter->Emit(T::NAME, signal, args...);
+				});
+			}
+
+			return;
+		}
+
+		// Nothing can be listening before the first signal is pushed
+		if (!emitter) {
+			return;
+		}
+
 		emitter->Emit(T::NAME, signal, args...);
 	}
 
 	template <typename T>
 	void Changed(std::string_view propName) {
+		// Listeners are only known once the parallel phase ends
+		bool parallel = TaskScheduler::GetParallelScheduler() != nullptr;
+		if (!parallel && (!emitter || !emitter->HasListeners())) {
+			return;
+		}
+
 		const ClassDB::Property *prop = ClassDB::GetProperty(T::NAME, propName);
 		if (!prop) {
 			return;
 		}
 
-		Emit<T>(prop->changedSignal);
-		Emit<T>("Changed", prop->name);
+		// Listeners of unrelated signals (e.g. Touched) do not make property
+		// changes pay for emitting
+		if (parallel || emitter->HasListeners(prop->changedSignalId)) {
+			Emit<T>(prop->changedSignalId);
+		}
+
+		if (parallel || emitter->HasListeners(signalId<"Changed">)) {
+			Emit<T, "Changed">(prop->name);
+		}
 	}
 
 	template <typename T, typename... Args>
@@ -250,7 +336,42 @@ protected:
 	}
 
 private:
+	friend void luaSBX_pushobject(lua_State *L, const std::shared_ptr<Object> &object);
+	friend void luaSBX_objectdtor(lua_State *L, void *udata);
+
+	// Userdata cache for a given VM
+	struct LuauHandle {
+		const SbxGlobalThreadData *vm = nullptr;
+		const void *udata = nullptr;
+		int slot = 0;
+	};
+
+	// Guards emitter creation and luauHandles, which VMs in the parallel phase
+	// may access concurrently. Never held while running Luau code or
+	// allocating from a VM.
+	class LuauLock {
+	public:
+		explicit LuauLock(const Object &object) :
+				flag(object.luauLock) {
+			while (flag.test_and_set(std::memory_order_acquire)) {
+			}
+		}
+
+		~LuauLock() { flag.clear(std::memory_order_release); }
+
+		LuauLock(const LuauLock &other) = delete;
+		LuauLock &operator=(const LuauLock &other) = delete;
+
+	private:
+		std::atomic_flag &flag;
+	};
+
+	LuauHandle *FindLuauHandle(const SbxGlobalThreadData *vm);
+
+	// Created lazily by PushSignal, since most objects are never listened to
 	std::shared_ptr<SignalEmitter> emitter;
+	std::vector<LuauHandle> luauHandles;
+	mutable std::atomic_flag luauLock;
 	/* END USER CODE ClassExtra2 */
 	// clang-format off
 };
@@ -74,17 +74,17 @@ protected:
 	static void BindMembers() {
 		Instance::BindMembers<T>();
 
-		// Vector3 properties via custom index/newindex
-		LuauClassBinder<T>::AddIndexOverride(PartIndexOverride);
-		LuauClassBinder<T>::AddNewindexOverride(PartNewindexOverride);
+		// Vector3 properties via custom Luau accessors
+		ClassDB::BindLuauProperty<T, "Size", &Part::GetSizeLuau, &Part::SetSizeLuau, ThreadSafety::ReadSafe>();
+		ClassDB::BindLuauProperty<T, "Position", &Part::GetPositionLuau, &Part::SetPositionLuau, ThreadSafety::ReadSafe>();
 
 		// Register Size and Position in ClassDB for reflection (not scriptable via normal path)
 		ClassDB::BindPropertyNotScriptable<T, "Size", "Part",
 				&Part::GetSize, &Part::SetSize,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 		ClassDB::BindPropertyNotScriptable<T, "Position", "Part",
 				&Part::GetPosition, &Part::SetPosition,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 
 		// Simple properties
 		ClassDB::BindProperty<T, "Anchored", "Part", &Part::GetAnchored, NoneSecurity,
@@ -108,10 +108,6 @@ private:
 	bool canCollide = true;
 	double transparency = 0.0;
 	bool canTouch = true;
-
-	// Custom index/newindex overrides for Vector3 properties
-	static int PartIndexOverride(lua_State *L, const char *propName);
-	static bool PartNewindexOverride(lua_State *L, const char *propName);
 };
 
 } //namespace SBX::Classes
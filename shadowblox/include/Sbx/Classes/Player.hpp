@@ -63,14 +63,13 @@ protected:
 	static void BindMembers() {
 		Instance::BindMembers<T>();
 
-		// Character via custom index/newindex
-		LuauClassBinder<T>::AddIndexOverride(PlayerIndexOverride);
-		LuauClassBinder<T>::AddNewindexOverride(PlayerNewindexOverride);
+		// Character via custom Luau accessors
+		ClassDB::BindLuauProperty<T, "Character", &Player::GetCharacterLuau, &Player::SetCharacterLuau, ThreadSafety::ReadSafe>();
 
 		// Register Character in ClassDB for reflection (not scriptable via normal path)
 		ClassDB::BindPropertyNotScriptable<T, "Character", "Player",
 				&Player::GetCharacter, &Player::SetCharacter,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 
 		// Simple properties
 		ClassDB::BindProperty<T, "UserId", "Player", &Player::GetUserId, NoneSecurity,
@@ -90,10 +89,6 @@ private:
 	int64_t userId = 0;
 	std::string displayName;
 	std::string teamColor;
-
-	// Custom index/newindex overrides for Character property
-	static int PlayerIndexOverride(lua_State *L, const char *propName);
-	static bool PlayerNewindexOverride(lua_State *L, const char *propName);
 };
 
 } // namespace SBX::Classes
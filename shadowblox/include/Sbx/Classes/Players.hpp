@@ -76,8 +76,8 @@ protected:
 	static void BindMembers() {
 		Instance::BindMembers<T>();
 
-		// LocalPlayer via custom index
-		LuauClassBinder<T>::AddIndexOverride(PlayersIndexOverride);
+		// LocalPlayer via custom Luau accessor
+		LuauClassBinder<T>::template BindLuauProperty<"LocalPlayer", &Players::GetLocalPlayerLuau>();
 
 		// Register LocalPlayer in ClassDB for reflection (not scriptable via normal path)
 		ClassDB::BindPropertyNotScriptable<T, "LocalPlayer", "Players",
@@ -107,9 +107,6 @@ private:
 	std::weak_ptr<Player> localPlayer;
 	std::unordered_map<int64_t, std::weak_ptr<Player>> playersByUserId;
 	int maxPlayers = 50;
-
-	// Custom index override for LocalPlayer property
-	static int PlayersIndexOverride(lua_State *L, const char *propName);
 };
 
 } // namespace SBX::Classes
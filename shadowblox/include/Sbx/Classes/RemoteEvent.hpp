@@ -21,21 +21,12 @@
 #include "lua.h"
 
 #include "Sbx/Classes/Instance.hpp"
+#include "Sbx/Runtime/Base.hpp"
 
 namespace SBX::Classes {
 
 class Player;
 
-/**
- * @brief Callback type for handling network events from the engine.
- *
- * The callback receives:
- * - eventName: The name of the RemoteEvent
- * - targetId: For FireClient, the player ID to send to (-1 for all clients)
- * - data: Serialized Luau values
- */
-using NetworkEventCallback = std::function<void(const char *eventName, int64_t targetId, const std::vector<uint8_t> &data)>;
-
 /**
  * @brief This class implements Roblox's [`RemoteEvent`](https://create.roblox.com/docs/reference/engine/classes/RemoteEvent)
  * class.
@@ -70,7 +61,8 @@ public:
 	void OnServerEvent(std::shared_ptr<Player> player, lua_State *L, const std::vector<uint8_t> &data);
 	void OnClientEvent(lua_State *L, const std::vector<uint8_t> &data);
 
-	// Set network callback (called by engine to register transport)
+	// Set network callback (called by engine to register transport). VMs
+	// with their own callback (see SbxGlobalThreadData) use that instead.
 	static void SetNetworkCallback(NetworkEventCallback callback);
 	static NetworkEventCallback GetNetworkCallback();
 
@@ -21,22 +21,12 @@
 #include "lua.h"
 
 #include "Sbx/Classes/Instance.hpp"
+#include "Sbx/Runtime/Base.hpp"
 
 namespace SBX::Classes {
 
 class Player;
 
-/**
- * @brief Callback type for handling network function calls from the engine.
- *
- * The callback receives:
- * - functionName: The name of the RemoteFunction
- * - targetId: For InvokeClient, the player ID to call on
- * - data: Serialized Luau values
- * Returns: Serialized return values
- */
-using NetworkFunctionCallback = std::function<std::vector<uint8_t>(const char *functionName, int64_t targetId, const std::vector<uint8_t> &data)>;
-
 /**
  * @brief This class implements Roblox's [`RemoteFunction`](https://create.roblox.com/docs/reference/engine/classes/RemoteFunction)
  * class.
@@ -67,7 +57,8 @@ public:
 	std::vector<uint8_t> HandleServerInvoke(std::shared_ptr<Player> player, lua_State *L, const std::vector<uint8_t> &data);
 	std::vector<uint8_t> HandleClientInvoke(lua_State *L, const std::vector<uint8_t> &data);
 
-	// Set network callback
+	// Set network callback. VMs with their own callback (see
+	// SbxGlobalThreadData) use that instead.
 	static void SetNetworkCallback(NetworkFunctionCallback callback);
 	static NetworkFunctionCallback GetNetworkCallback();
 
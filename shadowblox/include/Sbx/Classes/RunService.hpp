@@ -19,6 +19,7 @@
 #include "lua.h"
 
 #include "Sbx/Classes/Instance.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
 
 namespace SBX::Classes {
 
@@ -52,6 +53,22 @@ public:
 	void FireHeartbeat(double dt);
 	void FireRenderStepped(double dt);
 
+	/**
+	 * @brief Run one frame: RenderStepped (client only), Stepped, then
+	 * Heartbeat.
+	 *
+	 * Each signal is followed by resuming the scheduler at the matching
+	 * resumption points, so deferred events and yielded threads run in a
+	 * fixed order. Calling the Fire methods individually treats each call as
+	 * its own frame.
+	 *
+	 * @param dt The time since the last frame.
+	 */
+	void StepFrame(double dt);
+
+	// The scheduler resumed by the Fire methods, if any
+	void SetScheduler(TaskScheduler *value) { scheduler = value; }
+
 	// Pause/Resume (for editor)
 	void Pause();
 	void Run();
@@ -109,6 +126,14 @@ private:
 	bool isEdit = true;
 	double deltaTime = 0.0;
 	double elapsedTime = 0.0;
+
+	TaskScheduler *scheduler = nullptr;
+	uint64_t frame = 0;
+	bool inFrame = false;
+	bool frameResumed = false;
+
+	void BeginFrame();
+	void ResumeTasks(ResumptionPoint point, double dt);
 };
 
 } // namespace SBX::Classes
@@ -20,6 +20,7 @@
 #include "lua.h"
 
 #include "Sbx/Classes/Instance.hpp"
+#include "Sbx/Runtime/Base.hpp"
 
 namespace SBX::Classes {
 
@@ -49,6 +50,10 @@ public:
 	const char *GetRunContext() const { return runContext.c_str(); }
 	void SetRunContext(const char *context);
 
+	// CPU time charged to this script, when assigned to its thread's
+	// SbxThreadData::cpuUsage by the host
+	const std::shared_ptr<SbxCpuUsage> &GetCpuUsage() const { return cpuUsage; }
+
 protected:
 	template <typename T>
 	static void BindMembers() {
@@ -67,6 +72,7 @@ private:
 	std::string source;
 	bool disabled = false;
 	std::string runContext = "Legacy";
+	std::shared_ptr<SbxCpuUsage> cpuUsage = std::make_shared<SbxCpuUsage>();
 };
 
 /**
@@ -172,19 +172,16 @@ protected:
 		ValueBase::BindMembers<T>();
 
 		// ObjectValue needs custom handling for Instance references
-		LuauClassBinder<T>::AddIndexOverride(ObjectValueIndexOverride);
-		LuauClassBinder<T>::AddNewindexOverride(ObjectValueNewindexOverride);
+		ClassDB::BindLuauProperty<T, "Value", &ObjectValue::GetValueLuau, &ObjectValue::SetValueLuau, ThreadSafety::ReadSafe>();
 
 		ClassDB::BindPropertyNotScriptable<T, "Value", "Data",
 				&ObjectValue::GetValue, &ObjectValue::SetValue,
-				ThreadSafety::Unsafe, true, true>({});
+				ThreadSafety::ReadSafe, true, true>({});
 	}
 
 private:
 	std::weak_ptr<Instance> value;
 
-	static int ObjectValueIndexOverride(lua_State *L, const char *propName);
-	static bool ObjectValueNewindexOverride(lua_State *L, const char *propName);
 };
 
 } // namespace SBX::Classes
@@ -16,7 +16,6 @@
 
 #include <cstdint>
 #include <memory>
-#include <string>
 
 #include "lua.h"
 
@@ -37,12 +36,12 @@ namespace SBX::DataTypes {
 class RBXScriptConnection {
 public:
 	RBXScriptConnection(); // required for stack operation
-	RBXScriptConnection(std::shared_ptr<SignalEmitter> emitter, std::string name, uint64_t id);
+	RBXScriptConnection(std::shared_ptr<SignalEmitter> emitter, int signal, uint64_t id);
 
 	static void Register(lua_State *L);
 
 	bool IsConnected() const;
-	void Disconnect();
+	static int Disconnect(lua_State *L);
 
 	const char *ToString() const;
 
@@ -50,7 +49,7 @@ private:
 	// Hold this reference to force connections to stay connected once the
 	// emitter owner is collected.
 	std::shared_ptr<SignalEmitter> emitter;
-	std::string name;
+	int signal;
 	uint64_t id;
 };
 
@@ -37,22 +37,25 @@ namespace SBX::DataTypes {
 class RBXScriptSignal {
 public:
 	RBXScriptSignal(); // required for stack operation
-	RBXScriptSignal(std::shared_ptr<SignalEmitter> emitter, std::string name, SbxCapability security = NoneSecurity);
+	RBXScriptSignal(std::shared_ptr<SignalEmitter> emitter, int signal, SbxCapability security = NoneSecurity);
 
 	static void Register(lua_State *L);
 
 	static int Connect(lua_State *L);
 	static int Once(lua_State *L);
 	static int Wait(lua_State *L);
+	static int ConnectParallel(lua_State *L);
 
 	std::string ToString() const;
 	bool operator==(const RBXScriptSignal &other) const;
 
 private:
+	static int Connect(lua_State *L, bool once, bool parallel);
+
 	// Hold this reference to allow this object to continue working after the
 	// emitter owner is collected.
 	std::shared_ptr<SignalEmitter> emitter;
-	std::string name;
+	int signal = -1;
 	SbxCapability security = NoneSecurity;
 };
 
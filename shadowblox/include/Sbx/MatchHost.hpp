@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Sbx/Runtime/Base.hpp"
+
+namespace SBX {
+class Logger;
+class LuauRuntime;
+class RuntimePool;
+class TaskScheduler;
+class ThreadPool;
+class Watchdog;
+struct PooledRuntime;
+} //namespace SBX
+
+namespace SBX::Classes {
+class DataModel;
+}
+
+namespace SBX {
+
+using MatchId = uint64_t;
+
+/**
+ * @brief Runs many isolated DataModels, each with its own runtime, in one
+ * process without a game engine.
+ *
+ * Every match has its own VMs, task scheduler and logger, and is ticked at its
+ * own rate. Matches are ticked concurrently on a thread pool, each by one
+ * thread at a time.
+ *
+ * State shared by all VMs (class information and atoms) is initialized when
+ * the host is created, then frozen so that it can be read without locking.
+ * It is unfrozen again when the host is destroyed, unless frozen elsewhere.
+ * Network transport is set per match rather than on RemoteEvent and
+ * RemoteFunction.
+ *
+ * Matches must only be created, destroyed and configured on the thread which
+ * calls @ref Step, and not during it.
+ */
+class MatchHost {
+public:
+	/**
+	 * @param numWorkers The number of worker threads, not counting the thread
+	 * which calls @ref Step.
+	 * @param poolSize The number of runtimes to keep ready for new matches, at
+	 * least one.
+	 * @param freezeSharedState Whether to freeze shared state once classes are
+	 * initialized, until the host is destroyed. Hosts passing false must
+	 * freeze it themselves before ticking matches concurrently.
+	 */
+	MatchHost(int numWorkers, size_t poolSize, bool freezeSharedState = true);
+	~MatchHost();
+
+	MatchHost(const MatchHost &other) = delete;
+	MatchHost(MatchHost &&other) = delete;
+	MatchHost &operator=(const MatchHost &other) = delete;
+	MatchHost &operator=(MatchHost &&other) = delete;
+
+	/**
+	 * @brief Start a match, with its RunService running.
+	 *
+	 * @param tickRate Ticks per second, or 0 to tick once per @ref Step.
+	 * @return The match's ID.
+	 */
+	MatchId CreateMatch(double tickRate = 60.0);
+	void DestroyMatch(MatchId id);
+	bool HasMatch(MatchId id) const;
+	size_t NumMatches() const { return matches.size(); }
+
+	LuauRuntime *GetRuntime(MatchId id) const;
+	std::shared_ptr<Classes::DataModel> GetDataModel(MatchId id) const;
+	TaskScheduler *GetScheduler(MatchId id) const;
+	// Hooks run on whichever thread ticks the match
+	Logger *GetLogger(MatchId id) const;
+
+	/**
+	 * @brief Set the transport for a match's RemoteEvents and RemoteFunctions.
+	 *
+	 * Callbacks run on whichever thread ticks the match.
+	 */
+	void SetNetworkCallbacks(MatchId id, NetworkEventCallback event, NetworkFunctionCallback function);
+
+	/**
+	 * @brief Advance every match by the given time, returning once all are
+	 * done.
+	 *
+	 * Matches run as many ticks as are due at their tick rate, up to a limit.
+	 * Time beyond the limit is dropped, so that a match which falls behind
+	 * does not keep falling further behind.
+	 *
+	 * @param delta The time since the last call.
+	 */
+	void Step(double delta);
+
+	// CPU time (s) spent on the match in the last call to Step
+	double GetStepTime(MatchId id) const;
+
+private:
+	struct Match {
+		// Declared before the runtime so that they outlive its VMs
+		std::unique_ptr<Logger> logger;
+		std::unique_ptr<TaskScheduler> scheduler;
+		std::unique_ptr<PooledRuntime> pooled;
+
+		double tickInterval = 0.0; // s, or 0 to tick every Step
+		double pending = 0.0; // time not yet ticked
+		double stepTime = 0.0;
+	};
+
+	static void StepMatch(Match &match, double delta);
+	Match *GetMatch(MatchId id) const;
+
+	std::unique_ptr<Watchdog> watchdog;
+	std::unique_ptr<ThreadPool> threadPool;
+	std::unique_ptr<RuntimePool> runtimePool;
+
+	MatchId nextId = 1;
+	std::unordered_map<MatchId, std::unique_ptr<Match>> matches;
+	std::vector<Match *> active; // ticked by Step, in no particular order
+};
+
+} //namespace SBX
@@ -14,13 +14,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "lua.h"
 
 #define luaSBX_noproperror(L, propertyName, className) luaL_error(L, "%s is not a valid member of %s", propertyName, className)
 #define luaSBX_propwriteonlyerror(L, propertyName, className) luaL_error(L, "%s member of %s is write-only and cannot be cannot be read", propertyName, className)
 #define luaSBX_propreadonlyerror(L, propertyName, className) luaL_error(L, "%s member of %s is read-only and cannot be assigned to", propertyName, className)
+#define luaSBX_cbwriteonlyerror(L, callbackName, className) luaL_error(L, "%s is a callback member of %s; you can only set the callback value, get is not available", callbackName, className)
 
 #define luaSBX_aritherror1type(L, op, type) luaL_error(L, "attempt to perform arithmetic (%s) on %s", op, type)
 #define luaSBX_aritherror2type(L, op, lhsType, rhsType) luaL_error(L, "attempt to perform arithmetic (%s) on %s and %s", op, lhsType, rhsType)
@@ -33,11 +39,13 @@
 #define luaSBX_casterror(L, from, to) luaL_error(L, "Unable to cast %s to %s", from, to)
 
 #define luaSBX_noschederror(L) luaL_error(L, "missing task scheduler")
+#define luaSBX_parallelerror(L, action, target) luaL_error(L, "%s is not safe to %s in parallel", target, action)
 #define luaSBX_nologerror(L) luaL_error(L, "missing logger")
 
 namespace SBX {
 
 class Logger;
+class SlabAllocator;
 class TaskScheduler;
 class SignalConnectionOwner;
 
@@ -53,6 +61,9 @@ enum UdataTag : uint8_t {
 	Vector3Udata = 6,
 	Color3Udata = 7,
 
+	// Shared by all Object classes, which carry their class ID
+	ObjectUdata = 8,
+
 	Test1Udata = 124,
 	Test2Udata = 125,
 	Test3Udata = 126,
@@ -104,29 +115,168 @@ enum VMType : uint8_t {
 	VMMax
 };
 
+/**
+ * @brief CPU time spent running Luau code on behalf of a script.
+ *
+ * Shared by all threads created from the script's thread, so work done in
+ * spawned threads and signal handlers is charged to the script. Threads of a
+ * script may run concurrently in the parallel phase, so counters are atomic.
+ */
+struct SbxCpuUsage {
+	std::atomic<double> time = 0.0; // seconds
+	std::atomic<uint64_t> resumptions = 0;
+
+	// Reference to the script's function, held until it is compiled natively
+	// once hot (see @ref luaSBX_loadnative) or the script stops. Only used in
+	// the serial phase.
+	int nativeRef = LUA_NOREF;
+	// Live threads charged to the script. The script has stopped once none
+	// are left. Only changed by the script's VM.
+	int numThreads = 0;
+};
+
+enum class NativeCodeMode : uint8_t {
+	Disabled,
+	// Scripts annotated with --!native, and scripts which become hot
+	Annotated,
+	// All scripts, when loaded
+	All
+};
+
+/**
+ * @brief Callback sending a RemoteEvent's arguments over the network.
+ *
+ * The callback receives:
+ * - eventName: The name of the RemoteEvent
+ * - targetId: The player ID to send to, -1 for all clients, or 0 for the server
+ * - data: Serialized Luau values
+ */
+using NetworkEventCallback = std::function<void(const char *eventName, int64_t targetId, const std::vector<uint8_t> &data)>;
+
+/**
+ * @brief Callback invoking a RemoteFunction over the network, returning the
+ * serialized response.
+ */
+using NetworkFunctionCallback = std::function<std::vector<uint8_t>(const char *functionName, int64_t targetId, const std::vector<uint8_t> &data)>;
+
+struct SbxNativeStats {
+	uint64_t functionsCompiled = 0;
+	uint64_t bytesCompiled = 0; // machine code
+	uint64_t hotScripts = 0; // compiled once hot
+};
+
 struct SbxGlobalThreadData {
 	double initTimestamp = 0.0;
 	Logger *logger = nullptr;
 	TaskScheduler *scheduler = nullptr;
+	SlabAllocator *allocator = nullptr; // owned, if the VM uses one
+	bool closing = false; // set once lua_close is called
+
+	// Every connection made from this VM, disconnected before it is closed so
+	// that objects outliving the VM do not release references into it
+	SignalConnectionOwner *connections = nullptr; // owned
+
+	// Native code generation, available if the platform supports it
+	NativeCodeMode nativeMode = NativeCodeMode::Annotated;
+	double nativeHotThreshold = 0.05; // seconds of CPU time per script, or 0
+	SbxNativeStats nativeStats;
+
+	// Network transport of this VM's RemoteEvents and RemoteFunctions, for
+	// hosts running several DataModels. If unset, the callbacks set on those
+	// classes are used.
+	NetworkEventCallback networkEventCallback;
+	NetworkFunctionCallback networkFunctionCallback;
+
+	// Integer slots in the weak object registry, assigned to objects
+	int objSlotCount = 0;
+	std::vector<int> freeObjSlots;
+
+	// Integer slots in the thread registry, assigned to scheduled threads
+	int threadSlotCount = 0;
+	std::vector<int> freeThreadSlots;
+
+	// Set while this VM runs on a worker in the parallel phase. Objects
+	// collected meanwhile are released once the phase ends, since their
+	// destruction may touch other VMs.
+	bool parallelPhase = false;
+	std::vector<std::shared_ptr<void>> parallelReleases;
 };
 
 struct SbxThreadData {
 	VMType vmType = VMMax;
 	SbxIdentity identity = AnonymousIdentity;
 	int32_t additionalCapability = 0;
-	uint64_t interruptDeadline = 0;
+	uint64_t interruptDeadline = 0; // ms, as returned by Watchdog::Now, or 0 for none
 
 	int objRegistry = LUA_NOREF;
 	int weakObjRegistry = LUA_NOREF;
+	int classMetatables = LUA_NOREF;
+	int signalCache = LUA_NOREF;
+	int threadRegistry = LUA_NOREF;
 
 	SignalConnectionOwner *signalConnections = nullptr;
 
+	// Whether the thread runs in the parallel phase (task.desynchronize),
+	// where only thread safe members may be used
+	bool desynchronized = false;
+
+	// Seconds spent resuming this thread, excluding nested resumptions
+	double cpuTime = 0.0;
+	std::shared_ptr<SbxCpuUsage> cpuUsage; // inherited by new threads, see luaSBX_setcpuusage
+
 	SbxGlobalThreadData *global = nullptr;
 	void *userdata = nullptr;
 };
 
-lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity);
+/**
+ * @brief Create a VM.
+ *
+ * @param vmType The type of the VM.
+ * @param defaultIdentity The identity of the main thread.
+ * @param slabAllocator Whether to serve the VM's allocations from a
+ * @ref SlabAllocator, which also reports per-VM memory usage.
+ */
+lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity, bool slabAllocator = false);
 lua_State *luaSBX_newthread(lua_State *L, SbxIdentity identity);
+
+/**
+ * @brief Keep a thread alive until it is released with
+ * @ref luaSBX_unrefthread.
+ *
+ * Slots are recycled, so repeatedly scheduling threads does not grow the
+ * registry.
+ *
+ * @param T The thread.
+ * @return The slot holding the thread.
+ */
+int luaSBX_refthread(lua_State *T);
+void luaSBX_unrefthread(lua_State *T, int slot);
+
+/**
+ * @brief Compile a loaded script to native code according to the VM's
+ * @ref NativeCodeMode.
+ *
+ * Scripts which are not compiled when loaded are compiled later if their CPU
+ * usage (as charged to @p usage) reaches the VM's hot threshold.
+ *
+ * @param L The Luau state.
+ * @param index The index of the script's function.
+ * @param usage The script's CPU usage, or nullptr.
+ * @return Whether any function was compiled.
+ */
+bool luaSBX_loadnative(lua_State *L, int index, SbxCpuUsage *usage);
+
+/**
+ * @brief Charge a thread, and threads it creates, to a script's CPU usage.
+ *
+ * Once every thread charged to the usage is freed, the script is considered
+ * stopped and its function is no longer held for native compilation.
+ *
+ * @param T The thread.
+ * @param usage The script's CPU usage, or nullptr.
+ */
+void luaSBX_setcpuusage(lua_State *T, std::shared_ptr<SbxCpuUsage> usage);
+
 SbxThreadData *luaSBX_getthreaddata(lua_State *L);
 void luaSBX_close(lua_State *L);
 
@@ -135,11 +285,77 @@ int32_t identityToCapabilities(SbxIdentity identity);
 bool luaSBX_iscapability(lua_State *L, SbxCapability capability);
 void luaSBX_checkcapability(lua_State *L, SbxCapability capability, const char *action, const char *target);
 
+/**
+ * @brief Raise an error if the thread is desynchronized.
+ *
+ * @param L The thread.
+ * @param action The attempted action (e.g. "call").
+ * @param target The member being used.
+ */
+void luaSBX_checkserial(lua_State *L, const char *action, const char *target);
+
 bool luaSBX_pushregistry(lua_State *L, void *ptr, void *userdata, void (*push)(lua_State *L, void *ptr, void *userdata), bool weak);
 
+/**
+ * @brief Push a class metatable previously stored by index.
+ *
+ * This is used by classes which share a userdata tag, and therefore cannot
+ * use the per-tag metatable.
+ *
+ * @param L     The Luau state.
+ * @param index The index of the metatable, e.g., its class ID.
+ * @return Whether the metatable exists. If not, `nil` is pushed.
+ */
+bool luaSBX_pushclassmetatable(lua_State *L, int index);
+
+/**
+ * @brief Store the metatable on the top of the stack by index.
+ *
+ * @param L     The Luau state.
+ * @param index The index of the metatable.
+ * @see luaSBX_pushclassmetatable
+ */
+void luaSBX_setclassmetatable(lua_State *L, int index);
+
+/**
+ * @brief Register a string as an atom shared by all VMs.
+ *
+ * Strings interned after registration will carry the returned atom, which can
+ * then be retrieved through `lua_namecallatom` or `lua_tostringatom`. Atoms are
+ * dense, starting at zero. Registration should happen before any VM is
+ * created, as strings interned earlier are not updated.
+ *
+ * @param str The string.
+ * @return The atom, or -1 if no more atoms can be allocated or atoms are
+ * frozen.
+ */
+int16_t luaSBX_addatom(const char *str);
+
+/**
+ * @brief Stop registering new atoms.
+ *
+ * Atoms are looked up without locking whenever a VM interns a string. Hosts
+ * running VMs on several threads must freeze atoms before starting them.
+ * Calls are counted, and each must be matched by
+ * @ref luaSBX_unfreezeatoms to register atoms again.
+ */
+void luaSBX_freezeatoms();
+void luaSBX_unfreezeatoms();
+
+/**
+ * @brief Find a previously registered atom.
+ *
+ * @param str The string.
+ * @param len The length of the string.
+ * @return The atom, or -1 if the string is not registered.
+ */
+int16_t luaSBX_findatom(const char *str, size_t len);
+
 void luaSBX_debugcallbacks(lua_State *L);
 void luaSBX_cbinterrupt(lua_State *L, int gc);
 
+// Both charge the time spent to the thread and its SbxCpuUsage. A timeout of
+// 0 disables the time limit.
 int luaSBX_resume(lua_State *L, lua_State *from, int nargs, double timeout = 10.0);
 int luaSBX_pcall(lua_State *L, int nargs, int nresults, int errfunc, double timeout = 10.0);
 
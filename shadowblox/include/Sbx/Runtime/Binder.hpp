@@ -56,11 +56,21 @@ template <auto N>
 struct StringLiteral {
 	char value[N]{};
 
+	constexpr StringLiteral() = default;
+
 	constexpr StringLiteral(const char (&str)[N]) {
 		std::copy(str, str + N, value);
 	}
 };
 
+template <auto N, auto M>
+constexpr StringLiteral<N + M - 1> operator+(const StringLiteral<N> &lhs, const char (&rhs)[M]) {
+	StringLiteral<N + M - 1> res;
+	std::copy(lhs.value, lhs.value + N - 1, res.value);
+	std::copy(rhs, rhs + M, res.value + N - 1);
+	return res;
+}
+
 template <typename T, StringLiteral name, BindPurpose purpose, int ofs>
 inline T luaSBX_checkarg(lua_State *L, int index) {
 	if constexpr (DataTypes::EnumClassToEnum<T>::enumType) {
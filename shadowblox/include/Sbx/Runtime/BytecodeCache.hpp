@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Luau {
+struct CompileOptions;
+}
+
+namespace SBX {
+
+#define BYTECODE_CACHE_MAX_ENTRIES 1024
+
+struct BytecodeCacheStats {
+	uint64_t hits = 0;
+	uint64_t diskHits = 0; // also counted in hits
+	uint64_t misses = 0;
+	uint64_t evictions = 0;
+};
+
+/**
+ * @brief A content-addressed cache of compiled Luau bytecode.
+ *
+ * Entries are keyed by a hash of the source and compile options, so changing
+ * either compiles anew. The key is also salted with the bytecode version, so
+ * files persisted by another Luau version are never loaded. Compile errors
+ * are cached like any other result, since Luau encodes them in the bytecode.
+ * Persisted files carry the length and checksum of their bytecode, and files
+ * which fail to verify are compiled anew.
+ *
+ * At most `maxEntries` results are kept in memory; the least recently used
+ * is evicted first.
+ */
+class BytecodeCache {
+public:
+	/**
+	 * @param directory A directory to persist bytecode in across runs, or
+	 * empty to only cache in memory.
+	 * @param maxEntries The maximum number of results kept in memory.
+	 */
+	explicit BytecodeCache(std::string directory = "", size_t maxEntries = BYTECODE_CACHE_MAX_ENTRIES);
+
+	/**
+	 * @brief Get the bytecode of a source, compiling it on a miss.
+	 *
+	 * @param source The source.
+	 * @param opts The compile options.
+	 * @param optionsKey Distinguishes options which cannot be hashed (i.e.,
+	 * library member callbacks). Callers which set them must pass a key
+	 * unique to their behavior.
+	 * @return The bytecode, which can be passed to `luau_load`.
+	 */
+	std::string Compile(std::string_view source, const Luau::CompileOptions &opts, std::string_view optionsKey = {});
+
+	void Clear();
+
+	BytecodeCacheStats GetStats() const;
+	size_t Size() const;
+
+private:
+	// 128-bit key as 32 hex digits, also used as the file name
+	static std::string HashKey(std::string_view source, const Luau::CompileOptions &opts, std::string_view optionsKey);
+
+	bool LoadFile(const std::string &key, std::string &outBytecode) const;
+	void SaveFile(const std::string &key, const std::string &bytecode) const;
+
+	void Insert(std::string key, const std::string &bytecode);
+
+	std::string directory;
+	size_t maxEntries;
+
+	struct Entry {
+		std::string bytecode;
+		std::list<std::string>::iterator lruIt;
+	};
+
+	mutable std::mutex mutex;
+	std::unordered_map<std::string, Entry> entries;
+	// Most recently used first
+	std::list<std::string> lru;
+	BytecodeCacheStats stats;
+};
+
+} //namespace SBX
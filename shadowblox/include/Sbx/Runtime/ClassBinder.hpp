@@ -52,12 +52,17 @@ public:
 	 * @param newTypeId        The type ID for this class, to be recorded in its
 	 *                         metatable as __sbxtype. If negative, __sbxtype is
 	 *                         not populated.
+	 * @param newMetatableIndex The index to store the metatable at, for classes
+	 *                          which share a userdata tag. If negative, the
+	 *                          metatable is not stored by index.
+	 * @see luaSBX_pushclassmetatable
 	 */
-	static void Init(const char *newName, const char *newMetatableName, int newUdataTag = -1, int newTypeId = -1) {
+	static void Init(const char *newName, const char *newMetatableName, int newUdataTag = -1, int newTypeId = -1, int newMetatableIndex = -1) {
 		name = newName;
 		metatableName = newMetatableName;
 		udataTag = newUdataTag;
 		typeId = newTypeId;
+		metatableIndex = newMetatableIndex;
 	}
 
 	/**
@@ -97,9 +102,16 @@ public:
 	 * automatically. If provided, the userdata tag is set at this step.
 	 * Otherwise, the metatable is stored in a global table by name only.
 	 *
+	 * All members are merged into a single lookup table at this step, if any
+	 * were bound since the last call.
+	 *
 	 * @param L The Luau state.
 	 */
 	static void InitMetatable(lua_State *L) {
+		if (membersDirty) {
+			BuildMembers();
+		}
+
 		if (!luaL_newmetatable(L, metatableName)) {
 			luaL_error(L, "metatable '%s' already exists", metatableName);
 		}
@@ -141,6 +153,11 @@ public:
 		}
 
 		lua_setreadonly(L, -1, true);
+
+		if (metatableIndex >= 0) {
+			luaSBX_setclassmetatable(L, metatableIndex);
+		}
+
 		if (udataTag >= 0) {
 			lua_setuserdatametatable(L, udataTag);
 		} else {
@@ -203,6 +220,7 @@ public:
 			luaSBX_bindcxx<funcName, F, capability>,
 			std::string(name) + funcName.value
 		};
+		membersDirty = true;
 	}
 
 	/**
@@ -217,6 +235,7 @@ public:
 			F,
 			std::string(name) + funcName.value
 		};
+		membersDirty = true;
 	}
 
 	/**
@@ -239,6 +258,7 @@ public:
 			luaSBX_bindcxx<propName, G, getCapability, BindGetter>,
 			luaSBX_bindcxx<propName, S, setCapability, BindSetter>
 		};
+		membersDirty = true;
 	}
 
 	/**
@@ -257,6 +277,7 @@ public:
 			luaSBX_bindcxx<propName, G, getCapability, BindGetter>,
 			nullptr
 		};
+		membersDirty = true;
 	}
 
 	/**
@@ -275,6 +296,53 @@ public:
 			nullptr,
 			luaSBX_bindcxx<propName, S, setCapability, BindSetter>
 		};
+		membersDirty = true;
+	}
+
+	/**
+	 * @brief Bind a property implemented by Luau C functions.
+	 *
+	 * The getter receives `this` at index 1 and should push the property
+	 * value. The setter receives `this` at index 1 and the new value at index
+	 * 2.
+	 *
+	 * @tparam propName The property name.
+	 * @tparam G        The getter function.
+	 * @tparam S        The setter function, or `nullptr` if read-only.
+	 */
+	template <StringLiteral propName, lua_CFunction G, lua_CFunction S = nullptr>
+	static void BindLuauProperty() {
+		properties[propName.value] = { G, S };
+		membersDirty = true;
+	}
+
+	/**
+	 * @brief Bind a signal to Luau.
+	 *
+	 * The getter receives `this` at index 1 and should push the signal.
+	 *
+	 * @tparam sigName The signal name.
+	 * @tparam G       The getter function.
+	 */
+	template <StringLiteral sigName, lua_CFunction G>
+	static void BindSignal() {
+		signals[sigName.value] = G;
+		membersDirty = true;
+	}
+
+	/**
+	 * @brief Bind a callback to Luau.
+	 *
+	 * Callbacks can only be assigned to. The setter receives `this` at index 1
+	 * and the new value at index 2.
+	 *
+	 * @tparam cbName The callback name.
+	 * @tparam S      The setter function.
+	 */
+	template <StringLiteral cbName, lua_CFunction S>
+	static void BindCallback() {
+		callbacks[cbName.value] = S;
+		membersDirty = true;
 	}
 
 	/**
@@ -312,7 +380,9 @@ public:
 	 * The supplied function should take two parameters, the Luau state and the
 	 * requested property, and return the number of resulting items pushed onto
 	 * the stack. If the number of items is zero, the function results will
-	 * be ignored. The callbacks are evaluated in the order they are added in.
+	 * be ignored. The callbacks are evaluated in the order they are added in,
+	 * before any bound members. Prefer binding members by name where possible,
+	 * since overrides run on every access.
 	 *
 	 * @param func The function.
 	 */
@@ -383,6 +453,7 @@ private:
 	static const char *metatableName;
 	static int udataTag;
 	static int typeId;
+	static int metatableIndex;
 
 	struct Method {
 		lua_CFunction func = nullptr;
@@ -400,9 +471,30 @@ private:
 		TypePredicate rhsPredicate;
 	};
 
+	enum class MemberType : uint8_t {
+		Method,
+		Property,
+		Signal,
+		Callback,
+	};
+
+	struct Member {
+		MemberType type;
+		lua_CFunction getter = nullptr; // Method function for methods
+		lua_CFunction setter = nullptr;
+		const char *debugName = nullptr;
+	};
+
 	static StringMap<Method> staticMethods;
 	static StringMap<Method> methods;
 	static StringMap<Property> properties;
+	static StringMap<lua_CFunction> signals;
+	static StringMap<lua_CFunction> callbacks;
+
+	// All of the above, merged by BuildMembers
+	static bool membersDirty;
+	static StringMap<Member> members;
+	static std::vector<const Member *> membersByAtom;
 
 	static lua_CFunction tostringFunc;
 	static lua_CFunction callOperator;
@@ -415,12 +507,69 @@ private:
 	static std::unordered_map<TMS, lua_CFunction> operatorFunctions;
 	static std::unordered_map<TMS, std::vector<BinOp>> binaryOperators;
 
+	static void BuildMembers() {
+		members.clear();
+		membersByAtom.clear();
+
+		// Later entries take precedence
+		for (const auto &[methodName, method] : methods) {
+			members[methodName] = { MemberType::Method, method.func, nullptr, method.debugName.c_str() };
+		}
+
+		for (const auto &[propName, prop] : properties) {
+			members[propName] = { MemberType::Property, prop.getter, prop.setter };
+		}
+
+		for (const auto &[cbName, setter] : callbacks) {
+			members[cbName] = { MemberType::Callback, nullptr, setter };
+		}
+
+		for (const auto &[sigName, getter] : signals) {
+			members[sigName] = { MemberType::Signal, getter, nullptr };
+		}
+
+		for (const auto &[memberName, member] : members) {
+			int16_t atom = luaSBX_addatom(memberName.c_str());
+			if (atom < 0) {
+				continue;
+			}
+
+			if (atom >= static_cast<int>(membersByAtom.size())) {
+				membersByAtom.resize(atom + 1, nullptr);
+			}
+
+			membersByAtom[atom] = &member;
+		}
+
+		membersDirty = false;
+	}
+
+	static const Member *FindMember(const char *memberName, int atom) {
+		if (atom >= 0) {
+			return atom < static_cast<int>(membersByAtom.size()) ? membersByAtom[atom] : nullptr;
+		}
+
+		// Strings interned before the atom was registered have no atom
+		auto it = members.find(memberName);
+		return it != members.end() ? &it->second : nullptr;
+	}
+
+	static const char *CheckMemberName(lua_State *L, int *atom) {
+		if (const char *memberName = lua_tostringatom(L, 2, atom)) {
+			return memberName;
+		}
+
+		*atom = -1;
+		return luaL_checkstring(L, 2);
+	}
+
 	/* Metamethods */
 	static int Namecall(lua_State *L) {
-		if (const char *methodName = lua_namecallatom(L, nullptr)) {
-			auto it = methods.find(methodName);
-			if (it != methods.end()) {
-				return it->second.func(L);
+		int atom = -1;
+		if (const char *methodName = lua_namecallatom(L, &atom)) {
+			const Member *member = FindMember(methodName, atom);
+			if (member && member->type == MemberType::Method) {
+				return member->getter(L);
 			}
 
 			luaSBX_nomethoderror(L, methodName, name);
@@ -430,7 +579,8 @@ private:
 	}
 
 	static int Index(lua_State *L) {
-		const char *propName = luaL_checkstring(L, 2);
+		int atom = -1;
+		const char *propName = CheckMemberName(L, &atom);
 
 		for (IndexOverride func : indexOverrides) {
 			if (int nret = func(L, propName)) {
@@ -438,27 +588,32 @@ private:
 			}
 		}
 
-		auto it = properties.find(propName);
-		if (it != properties.end()) {
-			if (!it->second.getter) {
-				luaSBX_propwriteonlyerror(L, propName, name);
-			}
+		if (const Member *member = FindMember(propName, atom)) {
+			switch (member->type) {
+				case MemberType::Method:
+					lua_pushcfunction(L, member->getter, member->debugName);
+					return 1;
 
-			lua_remove(L, 2);
-			return it->second.getter(L);
-		}
+				case MemberType::Property:
+				case MemberType::Signal:
+					if (!member->getter) {
+						luaSBX_propwriteonlyerror(L, propName, name);
+					}
 
-		auto it2 = methods.find(propName);
-		if (it2 != methods.end()) {
-			lua_pushcfunction(L, it2->second.func, it2->second.debugName.c_str());
-			return 1;
+					lua_remove(L, 2);
+					return member->getter(L);
+
+				case MemberType::Callback:
+					luaSBX_cbwriteonlyerror(L, propName, name);
+			}
 		}
 
 		luaSBX_noproperror(L, propName, name);
 	}
 
 	static int Newindex(lua_State *L) {
-		const char *propName = luaL_checkstring(L, 2);
+		int atom = -1;
+		const char *propName = CheckMemberName(L, &atom);
 
 		for (NewindexOverride func : newindexOverrides) {
 			if (func(L, propName)) {
@@ -466,14 +621,14 @@ private:
 			}
 		}
 
-		auto it = properties.find(propName);
-		if (it != properties.end()) {
-			if (!it->second.setter) {
+		const Member *member = FindMember(propName, atom);
+		if (member && (member->type == MemberType::Property || member->type == MemberType::Callback)) {
+			if (!member->setter) {
 				luaSBX_propreadonlyerror(L, propName, name);
 			}
 
 			lua_remove(L, 2);
-			return it->second.setter(L);
+			return member->setter(L);
 		}
 
 		luaSBX_noproperror(L, propName, name);
@@ -513,6 +668,9 @@ int LuauClassBinder<T>::udataTag = -1;
 template <typename T>
 int LuauClassBinder<T>::typeId = -1;
 
+template <typename T>
+int LuauClassBinder<T>::metatableIndex = -1;
+
 template <typename T>
 StringMap<typename LuauClassBinder<T>::Method> LuauClassBinder<T>::staticMethods;
 
@@ -522,6 +680,21 @@ StringMap<typename LuauClassBinder<T>::Method> LuauClassBinder<T>::methods;
 template <typename T>
 StringMap<typename LuauClassBinder<T>::Property> LuauClassBinder<T>::properties;
 
+template <typename T>
+StringMap<lua_CFunction> LuauClassBinder<T>::signals;
+
+template <typename T>
+StringMap<lua_CFunction> LuauClassBinder<T>::callbacks;
+
+template <typename T>
+bool LuauClassBinder<T>::membersDirty = true;
+
+template <typename T>
+StringMap<typename LuauClassBinder<T>::Member> LuauClassBinder<T>::members;
+
+template <typename T>
+std::vector<const typename LuauClassBinder<T>::Member *> LuauClassBinder<T>::membersByAtom;
+
 template <typename T>
 lua_CFunction LuauClassBinder<T>::tostringFunc = nullptr;
 
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace Luau {
+struct CompileOptions;
+}
+
+namespace SBX {
+
+enum class CompileProfile : uint8_t {
+	// Full debug info, no optimization beyond the basics
+	Debug,
+	// Optimization level 2 (inlining, unrolling) with known library members
+	Release
+};
+
+/**
+ * @brief Get the shared compile options of a profile.
+ *
+ * @param profile The profile.
+ * @return The options, valid for the lifetime of the program.
+ */
+const Luau::CompileOptions &luaSBX_compileoptions(CompileProfile profile);
+
+/**
+ * @brief Get the name of a profile, which identifies its options for
+ * @ref BytecodeCache.
+ */
+const char *luaSBX_compileprofilename(CompileProfile profile);
+
+} //namespace SBX
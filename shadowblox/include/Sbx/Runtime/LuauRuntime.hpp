@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "lua.h"
 
@@ -24,7 +26,7 @@ namespace SBX {
 
 class LuauRuntime {
 public:
-	LuauRuntime(void (*initCallback)(lua_State *), bool debug = false);
+	LuauRuntime(void (*initCallback)(lua_State *), bool debug = false, bool slabAllocator = false);
 	~LuauRuntime();
 
 	LuauRuntime(const LuauRuntime &other) = delete;
@@ -34,12 +36,53 @@ public:
 
 	lua_State *GetVM(VMType type);
 
-	void GCStep(const uint32_t *step, double delta);
+	/**
+	 * @brief Create an actor, a user VM of its own.
+	 *
+	 * A VM runs one thread at a time, so desynchronized threads of one VM run
+	 * one after another in the parallel phase. Scripts run in separate actors
+	 * are resumed concurrently instead.
+	 *
+	 * The actor takes the user VM's logger, scheduler, network callbacks and
+	 * native code settings. Globals are registered by the host, as for the
+	 * user VM. Actors are closed with the runtime.
+	 *
+	 * @return The actor's main thread.
+	 */
+	lua_State *CreateActor();
+	size_t NumActors() const { return actors.size(); }
+	lua_State *GetActor(size_t index) const { return actors[index]; }
+
+	/**
+	 * @brief Step a VM's garbage collector.
+	 *
+	 * @param vm The VM.
+	 * @param stepKB The amount of work to do, in KB.
+	 * @return The time taken, in seconds.
+	 */
+	double GCStep(VMType vm, uint32_t stepKB);
+	static double GCStep(lua_State *L, uint32_t stepKB);
 	void GCSize(int32_t *outBuffer);
 
+	/**
+	 * @brief Get the bytes reserved for pages by the slab allocators of all
+	 * VMs, including actors.
+	 *
+	 * Pages are kept until the runtime is destroyed, so this is the peak
+	 * small-block usage rather than the current one. Call it where the VMs
+	 * could run, i.e., not during the parallel phase.
+	 *
+	 * @return The size, or 0 if the VMs do not use slab allocators.
+	 */
+	size_t GetPageBytes() const;
+
 private:
 	void (*initCallback)(lua_State *);
+	bool debug;
+	bool slabAllocator;
+
 	lua_State *vms[VMMax]{};
+	std::vector<lua_State *> actors;
 	void InitVM(lua_State *L, bool debug);
 };
 
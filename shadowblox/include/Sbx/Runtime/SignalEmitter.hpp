@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -26,7 +27,6 @@
 
 #include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/Stack.hpp"
-#include "Sbx/Runtime/StringMap.hpp"
 #include "Sbx/Runtime/TaskScheduler.hpp"
 
 namespace SBX {
@@ -38,7 +38,8 @@ void luaSBX_reentrancyerror(lua_State *L, const char *signalName);
 
 class SignalWaitTask : public ScheduledTask {
 public:
-	using ScheduledTask::ScheduledTask;
+	SignalWaitTask(lua_State *T, SignalEmitter *emitter, int signal);
+	~SignalWaitTask() override;
 
 	bool IsComplete(ResumptionPoint point) override;
 	int PushResults() override;
@@ -46,6 +47,10 @@ public:
 private:
 	friend class SignalEmitter;
 	std::function<int(lua_State *)> pushResults;
+	// Cleared once the signal fires or the emitter is destroyed. Otherwise,
+	// the task unregisters itself if cancelled (e.g. through task.cancel).
+	SignalEmitter *emitter;
+	int signal;
 };
 
 class SignalEmitter {
@@ -60,124 +65,192 @@ public:
 
 	// Shutdown mode - when true, all signal operations are skipped
 	// This prevents crashes when Luau runtime has been destroyed
+	// Set per thread, so that shutting down one host does not affect others
+	// running on other threads
 	static void SetShutdownMode(bool shutdown);
 	static bool IsShutdownMode();
 
+	/**
+	 * @brief Get the ID of a signal name, registering it if necessary.
+	 *
+	 * IDs are shared by all emitters and are dense, starting from 0. Safe to
+	 * call from any thread.
+	 *
+	 * @param name The name of the signal.
+	 * @return The ID of the signal.
+	 */
+	static int GetSignalId(std::string_view name);
+
+	/**
+	 * @brief Get the name of a signal from its ID.
+	 *
+	 * @param id The ID of the signal, as returned by @ref GetSignalId.
+	 * @return The name of the signal.
+	 */
+	static const std::string &GetSignalName(int id);
+
 	void SetDeferred(bool isDeferred);
 
-	uint64_t Connect(const std::string &signal, lua_State *L, bool once);
-	bool IsConnected(const std::string &signal, uint64_t id) const;
-	void Disconnect(const std::string &signal, uint64_t id, bool cancel = true, bool updateOwner = true);
-	int Wait(const std::string &signal, lua_State *L);
+	uint64_t Connect(int signal, lua_State *L, bool once, bool parallel = false);
+	bool IsConnected(int signal, uint64_t id) const;
+	void Disconnect(int signal, uint64_t id, bool cancel = true, bool updateOwner = true);
+	int Wait(int signal, lua_State *L);
 
 	int NumConnections() const;
 
+	// Whether any connection or waiting thread exists on any signal
+	bool HasListeners() const { return numListeners > 0; }
+	// Whether any connection or waiting thread exists on the given signal
+	bool HasListeners(int signal) const;
+
+	// Only called in the serial phase, since handlers run in their VMs.
+	// Objects defer signals fired in the parallel phase (see Object::Emit).
 	template <typename... Args>
-	void Emit(std::string_view className, std::string_view signal, Args... args) {
+	void Emit(std::string_view className, int signal, Args... args) {
 		// Skip all signal emission during shutdown to prevent crashes
-		if (shutdownMode) {
+		if (shutdownMode || !HasListeners(signal)) {
 			return;
 		}
 
-		std::vector<uint64_t> toRemove;
-
-		auto entry = connections.find(signal);
-		if (entry != connections.end() && deferred) {
-			// Do not fire new connections during iteration
-			auto connectionsCopy = entry->second;
-			for (const auto &[id, conn] : connectionsCopy) {
-				SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
-				if (!udata->global->scheduler) {
+		// NOTE: Handlers may connect to other signals on this emitter, which
+		// can move the signal states and reallocate the connection vectors.
+		// Look the state up again after running handlers, and do not hold
+		// references to them across calls.
+		if (!FindSignalState(signal)->connections.empty()) {
+			// Connections made during iteration are appended past `count` and
+			// not fired. Disconnected ones are tombstoned until iteration ends.
+			const size_t count = FindSignalState(signal)->connections.size();
+			FindSignalState(signal)->iterating++;
+
+			for (size_t i = 0; i < count; i++) {
+				const Connection conn = FindSignalState(signal)->connections[i];
+				if (conn.ref == LUA_NOREF) {
 					continue;
 				}
 
-				// Duplicate this reference: If this object is collected during
-				// the resumption period, then the original conn.ref will be
-				// destroyed before the resumption of the event handler.
-				lua_getref(conn.L, conn.ref);
-				int newRef = lua_ref(conn.L, -1);
-
-				bool created = udata->global->scheduler->AddDeferredEvent(this, id, conn.L, [=]() {
-					lua_getref(conn.L, newRef);
-					(LuauStackOp<Args>::Push(conn.L, args), ...);
-					luaSBX_pcall(conn.L, sizeof...(Args), 0, 0);
-					lua_unref(conn.L, newRef);
-				});
-
-				if (created) {
-					lua_pop(conn.L, 1); // function
+				if (conn.parallel) {
+					// Handlers run desynchronized in the next parallel phase,
+					// each on its own thread. Created here, in the serial
+					// phase, since no worker is running the VM meanwhile.
+					SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
+					if (udata->global->scheduler) {
+						lua_State *T = lua_newthread(conn.L);
+						lua_getref(T, conn.ref);
+						(LuauStackOp<Args>::Push(T, args), ...);
+
+						udata->global->scheduler->AddParallelThread(T, sizeof...(Args));
+						lua_pop(conn.L, 1); // thread
+					}
+				} else if (deferred) {
+					SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
+					if (!udata->global->scheduler) {
+						continue;
+					}
+
+					// Duplicate this reference: If this object is collected during
+					// the resumption period, then the original conn.ref will be
+					// destroyed before the resumption of the event handler.
+					lua_getref(conn.L, conn.ref);
+					int newRef = lua_ref(conn.L, -1);
+
+					bool created = udata->global->scheduler->AddDeferredEvent(this, conn.id, conn.L, [L = conn.L, newRef, args...]() {
+						lua_getref(L, newRef);
+						(LuauStackOp<Args>::Push(L, args), ...);
+						luaSBX_pcall(L, sizeof...(Args), 0, 0);
+						lua_unref(L, newRef);
+					});
+
+					if (created) {
+						lua_pop(conn.L, 1); // function
+					} else {
+						lua_unref(conn.L, newRef);
+
+						std::string debugName = std::string(className) + '.' + GetSignalName(signal);
+						luaSBX_reentrancyerror(conn.L, debugName.c_str());
+					}
 				} else {
-					std::string debugName = std::string(className) + '.' + std::string(signal);
-					luaSBX_reentrancyerror(conn.L, debugName.c_str());
+					lua_getref(conn.L, conn.ref);
+
+					bool firstEntrant = immediateReentrancy.empty();
+
+					if (++immediateReentrancy[conn.id] > IMMEDIATE_EVENT_REENTRANCY_LIMIT) {
+						std::string debugName = std::string(className) + '.' + GetSignalName(signal);
+						luaSBX_reentrancyerror(conn.L, debugName.c_str());
+					} else {
+						(LuauStackOp<Args>::Push(conn.L, args), ...);
+						luaSBX_pcall(conn.L, sizeof...(Args), 0, 0);
+					}
+
+					immediateReentrancy[conn.id]--;
+					if (firstEntrant) {
+						immediateReentrancy.clear();
+					}
 				}
 
 				if (conn.once) {
-					toRemove.push_back(id);
+					Disconnect(signal, conn.id, false);
 				}
 			}
-		} else if (entry != connections.end()) {
-			// Do not fire new connections during iteration
-			auto connectionsCopy = entry->second;
-			for (const auto &[id, conn] : connectionsCopy) {
-				// Deleted during iteration
-				if (!entry->second.contains(id)) {
-					continue;
-				}
-
-				lua_getref(conn.L, conn.ref);
 
-				bool firstEntrant = immediateReentrancy.empty();
-
-				if (++immediateReentrancy[id] > IMMEDIATE_EVENT_REENTRANCY_LIMIT) {
-					std::string debugName = std::string(className) + '.' + std::string(signal);
-					luaSBX_reentrancyerror(conn.L, debugName.c_str());
-				} else {
-					(LuauStackOp<Args>::Push(conn.L, args), ...);
-					luaSBX_pcall(conn.L, sizeof...(Args), 0, 0);
-				}
-
-				immediateReentrancy[id]--;
-				if (firstEntrant) {
-					immediateReentrancy.clear();
-				}
-
-				if (conn.once) {
-					toRemove.push_back(id);
-				}
-			}
-		}
-
-		for (uint64_t id : toRemove) {
-			Disconnect(std::string(signal), id, false);
+			EndIteration(signal);
 		}
 
-		auto tasks = pendingTasks.find(signal);
-		if (tasks != pendingTasks.end()) {
-			for (SignalWaitTask *task : tasks->second) {
+		SignalState *state = FindSignalState(signal);
+		std::list<SignalWaitTask *> &tasks = state->pendingTasks;
+		if (!tasks.empty()) {
+			for (SignalWaitTask *task : tasks) {
 				task->pushResults = [=](lua_State *L) -> int {
 					(LuauStackOp<Args>::Push(L, args), ...);
 					return sizeof...(Args);
 				};
+				task->emitter = nullptr;
 			}
 
-			tasks->second.clear();
+			numListeners -= tasks.size();
+			state->numListeners -= tasks.size();
+			tasks.clear();
 		}
 	}
 
 private:
+	friend class SignalWaitTask;
+
 	struct Connection {
+		uint64_t id;
 		lua_State *L;
-		int ref;
+		int ref; // LUA_NOREF once disconnected
 		bool once;
+		bool parallel; // ConnectParallel
 	};
 
-	static bool shutdownMode;
+	struct SignalState {
+		int signal;
+		// Sorted by ID, since IDs are allocated in increasing order
+		std::vector<Connection> connections;
+		std::list<SignalWaitTask *> pendingTasks;
+		// Connections and waiting threads
+		int numListeners = 0;
+		// Number of Emit calls currently iterating over connections
+		int iterating = 0;
+		bool hasTombstones = false;
+	};
+
+	static thread_local bool shutdownMode;
+
+	SignalState &GetSignalState(int signal);
+	SignalState *FindSignalState(int signal);
+	const SignalState *FindSignalState(int signal) const;
+	int FindConnection(int signal, uint64_t id) const;
+	void EndIteration(int signal);
+	void RemovePendingTask(int signal, SignalWaitTask *task);
 
 	bool deferred = false;
 	uint64_t nextId = 0;
+	int numListeners = 0;
 	std::unordered_map<uint64_t, int> immediateReentrancy;
-	StringMap<std::unordered_map<uint64_t, Connection>> connections;
-	StringMap<std::list<SignalWaitTask *>> pendingTasks;
+	// Signals listened to at some point, sorted by ID. Few signals of an
+	// object are listened to, so this stays small.
+	std::vector<SignalState> signals;
 };
 
 class SignalConnectionOwner {
@@ -187,11 +260,11 @@ public:
 
 protected:
 	friend class SignalEmitter;
-	void AddConnection(SignalEmitter *emitter, const std::string &name, uint64_t id);
+	void AddConnection(SignalEmitter *emitter, int signal, uint64_t id);
 	void RemoveConnection(SignalEmitter *emitter, uint64_t id);
 
 private:
-	std::unordered_map<SignalEmitter *, std::unordered_map<uint64_t, std::string>> connections;
+	std::unordered_map<SignalEmitter *, std::unordered_map<uint64_t, int>> connections;
 };
 
 } //namespace SBX
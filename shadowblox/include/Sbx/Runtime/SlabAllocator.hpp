@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace SBX {
+
+#define SLAB_GRANULARITY 16
+#define SLAB_CLASSES 32 // up to 512 bytes
+#define SLAB_PAGE_SIZE 65536
+
+/**
+ * @brief Allocation statistics of a @ref SlabAllocator.
+ */
+struct SlabStats {
+	// Requested bytes and blocks in use in each size class
+	size_t liveBytes[SLAB_CLASSES] = { 0 };
+	size_t liveBlocks[SLAB_CLASSES] = { 0 };
+
+	// Bytes in use by allocations too large for any size class
+	size_t largeBytes = 0;
+
+	// Bytes reserved for pages, whether or not they are in use. Never
+	// decreases, since pages are kept until the allocator is destroyed.
+	size_t pageBytes = 0;
+};
+
+/**
+ * @brief A size class allocator for a Luau VM.
+ *
+ * Small blocks are carved from pages owned by the allocator and recycled
+ * through a free list per size class, so allocating and freeing are O(1).
+ * Larger blocks are passed through to the system allocator.
+ *
+ * Pages are only returned to the system when the allocator is destroyed with
+ * its VM. Freed blocks are reused by their own size class, so a VM keeps the
+ * pages of its peak usage until it is closed.
+ *
+ * A VM only runs on one thread at a time, so the allocator is not
+ * synchronized. Debug builds assert that it is never used by two threads at
+ * once.
+ */
+class SlabAllocator {
+public:
+	SlabAllocator() = default;
+	~SlabAllocator();
+
+	SlabAllocator(const SlabAllocator &other) = delete;
+	SlabAllocator(SlabAllocator &&other) = delete;
+	SlabAllocator &operator=(const SlabAllocator &other) = delete;
+	SlabAllocator &operator=(SlabAllocator &&other) = delete;
+
+	/**
+	 * @brief The `lua_Alloc` function for a VM using this allocator.
+	 *
+	 * @param ud The allocator.
+	 */
+	static void *Alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+	void *Allocate(size_t size);
+	void *Reallocate(void *ptr, size_t osize, size_t nsize);
+	void Free(void *ptr, size_t size);
+
+	const SlabStats &GetStats() const { return stats; }
+
+	// Total requested bytes in use, including large allocations
+	size_t GetLiveBytes() const;
+
+	static size_t GetClassSize(size_t sizeClass) { return (sizeClass + 1) * SLAB_GRANULARITY; }
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	static size_t GetSizeClass(size_t size);
+	void *Carve(size_t sizeClass);
+
+	FreeBlock *freeLists[SLAB_CLASSES] = { nullptr };
+
+	// Unused space at the end of the newest page
+	char *pageCursor = nullptr;
+	char *pageEnd = nullptr;
+	std::vector<void *> pages;
+
+	SlabStats stats;
+
+	// Only checked in debug builds
+	std::atomic<bool> busy = false;
+};
+
+} //namespace SBX
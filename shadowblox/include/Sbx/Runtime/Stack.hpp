@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "lua.h"
@@ -261,6 +262,9 @@ struct LuauStackOp<const char *> {
 	static const char *Check(lua_State *L, int index);
 };
 
+// Points into the Luau string buffer; only valid while the value is on the stack
+STACK_OP_DEF(std::string_view)
+
 /* USERDATA: Use for (typ. immutable) objects owned by Luau */
 
 #define STACK_OP_UDATA_DEF(type)                           \
@@ -14,10 +14,14 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <list>
-#include <unordered_map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "lua.h"
 
@@ -27,12 +31,18 @@ namespace SBX {
 
 class LuauRuntime;
 class SignalEmitter;
+class ThreadPool;
+class WaitTask;
 
 // Luau uses 1 "step unit" ~= 1KiB
 // amount (bytes) = step << 10
 #define GC_RATE_MIN 50
 #define GC_RATE_INC 25
 #define GC_RATE_MAX 10000
+#define GC_BUDGET_DEFAULT 1000 // us per VM per frame
+#define GC_COST_INITIAL 1e-6 // s per KB, until measured
+#define GC_COST_MIN 1e-9
+#define GC_COST_SMOOTHING 0.25
 
 // https://create.roblox.com/docs/scripting/events/deferred#resumption-points
 enum class ResumptionPoint : uint8_t {
@@ -47,6 +57,8 @@ enum class ResumptionPoint : uint8_t {
 	BindToClose
 };
 
+#define RESUMPTION_POINT_MAX 9
+
 class ScheduledTask {
 public:
 	ScheduledTask(lua_State *T);
@@ -65,50 +77,310 @@ public:
 	virtual int PushResults() = 0;
 	virtual void Update(uint64_t frame, double delta) {} // NOLINT
 
+	// Tasks are allocated from per-thread free lists, since they are created
+	// and destroyed at a high rate
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
+
 private:
 	lua_State *T;
-	int threadRef;
+	int threadSlot; // see luaSBX_refthread
+};
+
+/**
+ * @brief A move-only `void()` callable which stores small closures inline.
+ *
+ * Closures up to @ref INLINE_SIZE bytes are stored without allocating, so
+ * reusing a queue slot for a new closure does not touch the heap.
+ */
+class DeferredCallback {
+public:
+	static constexpr size_t INLINE_SIZE = 64;
+
+	DeferredCallback() = default;
+
+	template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, DeferredCallback>>>
+	DeferredCallback(F &&func) { // NOLINT
+		using D = std::decay_t<F>;
+
+		if constexpr (sizeof(D) <= INLINE_SIZE && alignof(D) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<D>) {
+			new (storage) D(std::forward<F>(func));
+			ops = &InlineOps<D>::OPS;
+		} else {
+			*reinterpret_cast<D **>(storage) = new D(std::forward<F>(func));
+			ops = &HeapOps<D>::OPS;
+		}
+	}
+
+	DeferredCallback(DeferredCallback &&other) noexcept { *this = std::move(other); }
+
+	DeferredCallback &operator=(DeferredCallback &&other) noexcept {
+		if (this != &other) {
+			Reset();
+
+			if (other.ops) {
+				other.ops->move(storage, other.storage);
+				ops = other.ops;
+				other.ops = nullptr;
+			}
+		}
+
+		return *this;
+	}
+
+	DeferredCallback(const DeferredCallback &other) = delete;
+	DeferredCallback &operator=(const DeferredCallback &other) = delete;
+
+	~DeferredCallback() { Reset(); }
+
+	void operator()() { ops->invoke(storage); }
+	explicit operator bool() const { return ops != nullptr; }
+
+	void Reset() {
+		if (ops) {
+			ops->destroy(storage);
+			ops = nullptr;
+		}
+	}
+
+private:
+	struct Ops {
+		void (*invoke)(void *storage);
+		void (*move)(void *dst, void *src); // leaves src destroyed
+		void (*destroy)(void *storage);
+	};
+
+	template <typename D>
+	struct InlineOps {
+		static void Invoke(void *storage) { (*static_cast<D *>(storage))(); }
+		static void Move(void *dst, void *src) {
+			new (dst) D(std::move(*static_cast<D *>(src)));
+			static_cast<D *>(src)->~D();
+		}
+		static void Destroy(void *storage) { static_cast<D *>(storage)->~D(); }
+
+		static constexpr Ops OPS = { Invoke, Move, Destroy };
+	};
+
+	template <typename D>
+	struct HeapOps {
+		static void Invoke(void *storage) { (**static_cast<D **>(storage))(); }
+		static void Move(void *dst, void *src) { *static_cast<D **>(dst) = *static_cast<D **>(src); }
+		static void Destroy(void *storage) { delete *static_cast<D **>(storage); }
+
+		static constexpr Ops OPS = { Invoke, Move, Destroy };
+	};
+
+	alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+	const Ops *ops = nullptr;
 };
 
 struct DeferredEvent {
 	// Not to be dereferenced; may be collected prior to firing event
-	void *emitter;
-	uint64_t id;
-	lua_State *L;
-	std::function<void()> resume;
-
-	std::unordered_map<SignalEmitter *, std::unordered_map<uint64_t, int>> pathReentrancy;
+	void *emitter = nullptr;
+	uint64_t id = 0;
+	lua_State *L = nullptr; // nullptr if cancelled
+	int node = -1; // see TaskScheduler::EventNode
+	DeferredCallback resume;
 };
 
 class TaskScheduler {
 public:
 	TaskScheduler(LuauRuntime *runtime);
 
+	/**
+	 * @brief Switch to another runtime, e.g. one taken from a @ref RuntimePool.
+	 *
+	 * Tasks of the previous runtime's VMs must already be cancelled. GC
+	 * pacing starts over, since it was measured on the previous VMs.
+	 */
+	void SetRuntime(LuauRuntime *value);
+
 	void AddTask(ScheduledTask *task);
-	bool AddDeferredEvent(SignalEmitter *emitter, uint64_t id, lua_State *L, std::function<void()> resume);
+	// Timed tasks are kept ordered by wake time and are not polled
+	void AddTimer(WaitTask *task);
+
+	/**
+	 * @brief Resume a thread desynchronized in the next parallel phase.
+	 *
+	 * The parallel phase runs at the end of each call to Resume. Threads of
+	 * different VMs run concurrently on the thread pool, if one is set.
+	 *
+	 * @param T The thread.
+	 * @param nargs The number of values on the thread's stack to resume with.
+	 */
+	void AddParallelThread(lua_State *T, int nargs);
+	void SetThreadPool(ThreadPool *pool) { threadPool = pool; }
+
+	/**
+	 * @brief Get the scheduler whose parallel phase the calling thread is
+	 * running threads for, if any.
+	 */
+	static TaskScheduler *GetParallelScheduler() { return parallelScheduler; }
+
+	/**
+	 * @brief Run a callback on the thread running the parallel phase, once
+	 * all of its threads are done. Safe to call from workers.
+	 *
+	 * Used for work which may touch other VMs, such as firing signals.
+	 */
+	void DeferSerial(DeferredCallback &&callback);
+
+	template <typename F>
+	bool AddDeferredEvent(SignalEmitter *emitter, uint64_t id, lua_State *L, F &&resume) {
+		int node = AddEventNode(emitter, id);
+		if (node < 0) {
+			return false;
+		}
+
+		PushEvent({ emitter, id, L, node, DeferredCallback(std::forward<F>(resume)) });
+		return true;
+	}
+
 	void CancelTask(ScheduledTask *task);
+	// Cancels scheduled tasks (waits, etc.) but not deferred events
+	void CancelTasks(lua_State *L);
 	void CancelThread(lua_State *L);
+	// Cancels everything belonging to the VM of L, before it is closed
+	void CancelVM(lua_State *L);
 	void CancelEvents(SignalEmitter *emitter, uint64_t id);
 
 	int NumPendingTasks() const;
 	int NumPendingEvents() const;
 
+	// Sum of the deltas passed to Resume, used as the clock for timed tasks
+	double GetTime() const { return time; }
+
+	/**
+	 * @brief Limit the time spent resuming tasks at a resumption point.
+	 *
+	 * Once the budget is exhausted, remaining tasks are left for the next call
+	 * to Resume at any point, where they are visited first. At least one task
+	 * is resumed per call so that work always progresses. Deferred events are
+	 * not limited.
+	 *
+	 * @param point The resumption point.
+	 * @param microseconds The budget, or 0 for no limit.
+	 */
+	void SetBudget(ResumptionPoint point, uint32_t microseconds);
+	uint32_t GetBudget(ResumptionPoint point) const;
+
 	void Resume(ResumptionPoint point, uint64_t frame, double delta, double throttleThreshold);
-	void GCStep(double delta);
 
-	const uint32_t *GetGCStepSize() const { return gcCollectRate; }
+	/**
+	 * @brief Limit the time spent stepping each VM's garbage collector per
+	 * frame.
+	 *
+	 * Collection demanded by the allocation rate which does not fit in the
+	 * budget is carried over to later frames.
+	 *
+	 * @param microseconds The budget, or 0 for no limit.
+	 */
+	void SetGCBudget(uint32_t microseconds) { gcBudget = microseconds; }
+	uint32_t GetGCBudget() const { return gcBudget; }
+
+	/**
+	 * @brief Step each VM's garbage collector within the GC budget.
+	 *
+	 * Actors of the runtime are paced like the other VMs, each with a budget
+	 * of its own.
+	 *
+	 * @param delta The frame time.
+	 * @param spareTime Time left over in the frame after scripts have run,
+	 * shared between the VMs to catch up on carried over collection.
+	 */
+	void GCStep(double delta, double spareTime = 0.0);
+
+	// Paced VMs are indexed by VMType, followed by actors in creation order
+	size_t NumGCPacedVMs() const { return gcPacing.size(); }
+	// Step size (KB) and time (s) of a VM's last GC step
+	uint32_t GetGCStepSize(size_t index) const { return gcPacing[index].stepSize; }
+	double GetGCTime(size_t index) const { return gcPacing[index].time; }
 
 private:
+	template <typename F>
+	void CancelTimers(F pred);
+	template <typename F>
+	void CancelTasksIf(F pred);
+	void RemoveTasks(lua_State *L);
+	void ResumeThread(lua_State *T, int nargs);
+	void RunParallelPhase();
+
 	LuauRuntime *runtime;
+	ThreadPool *threadPool = nullptr;
+
+	// Guards task, timer and event queues against VMs in the parallel phase.
+	// Resume itself runs unlocked, since no worker runs alongside it.
+	std::mutex mutex;
+
+	struct ParallelTask {
+		lua_State *T;
+		ScheduledTask *task; // nullptr once resumed or cancelled
+	};
+
+	std::vector<ParallelTask> parallelTasks;
+	std::vector<ParallelTask> parallelBatch; // running
+	std::vector<DeferredCallback> serialCallbacks;
+
+	static thread_local TaskScheduler *parallelScheduler;
+
+	struct Timer {
+		double wakeTime;
+		uint64_t order; // FIFO among equal wake times
+		WaitTask *task;
+
+		bool operator>(const Timer &other) const {
+			return wakeTime > other.wakeTime || (wakeTime == other.wakeTime && order > other.order);
+		}
+	};
+
+	double time = 0.0;
+	uint64_t nextTimerOrder = 0;
+
+	uint32_t budgets[RESUMPTION_POINT_MAX] = { 0 };
+
+	// Each deferred event records the event which was running when it was
+	// queued. Reentrancy is counted along this chain rather than copied into
+	// every event. Nodes are discarded once the queue is drained.
+	struct EventNode {
+		const void *emitter;
+		uint64_t id;
+		int parent;
+		int count; // occurrences of (emitter, id) on the path, including this one
+	};
+
+	int AddEventNode(const void *emitter, uint64_t id);
+	void PushEvent(DeferredEvent &&ev);
+	template <typename F>
+	void CancelEventsIf(F pred);
+
+	std::list<ScheduledTask *> tasks; // nullptr once cancelled while resuming
+	bool resumingTasks = false;
+	std::vector<Timer> timers; // min-heap
+	std::vector<Timer> dueTimers;
+
+	// Ring buffer; size is zero or a power of two
+	std::vector<DeferredEvent> events;
+	size_t eventHead = 0;
+	size_t eventCount = 0;
+	int numPendingEvents = 0;
+
+	std::vector<EventNode> eventNodes;
+	int currentEvent = -1;
 
-	std::list<ScheduledTask *> tasks;
-	std::list<DeferredEvent> deferredEvents;
+	uint32_t gcBudget = GC_BUDGET_DEFAULT;
 
-	std::unordered_map<SignalEmitter *, std::unordered_map<uint64_t, int>> currentReentrancy;
+	struct GCPacing {
+		uint32_t collectRate = GC_RATE_MIN; // KB/s
+		int32_t sizeRate = 0;
+		int32_t lastSize = 0;
+		double debt = 0.0; // KB
+		double costPerKB = GC_COST_INITIAL;
+		uint32_t stepSize = 0;
+		double time = 0.0;
+	};
 
-	uint32_t gcCollectRate[VMMax] = { GC_RATE_MIN };
-	int32_t gcSizeRate[VMMax] = { 0 };
-	int32_t gcLastSize[VMMax] = { 0 };
+	std::vector<GCPacing> gcPacing;
 };
 
 void luaSBX_opensched(lua_State *L);
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SBX {
+
+/**
+ * @brief A fixed set of worker threads for running batches of independent
+ * jobs.
+ *
+ * Workers claim jobs from a shared counter, so long jobs do not hold up the
+ * rest of the batch.
+ */
+class ThreadPool {
+public:
+	/**
+	 * @param numWorkers The number of worker threads, not counting the thread
+	 * which calls @ref Run.
+	 */
+	explicit ThreadPool(int numWorkers);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &other) = delete;
+	ThreadPool(ThreadPool &&other) = delete;
+	ThreadPool &operator=(const ThreadPool &other) = delete;
+	ThreadPool &operator=(ThreadPool &&other) = delete;
+
+	/**
+	 * @brief Run `job(i)` for each `i` in `[0, count)`, returning once all have
+	 * finished.
+	 *
+	 * The calling thread also runs jobs. Jobs must not call Run.
+	 *
+	 * @param count The number of jobs.
+	 * @param job The job function.
+	 */
+	void Run(size_t count, const std::function<void(size_t)> &job);
+
+	int NumWorkers() const { return static_cast<int>(workers.size()); }
+
+private:
+	void WorkerMain();
+	void RunJobs();
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	// Current batch, guarded by mutex
+	const std::function<void(size_t)> *job = nullptr;
+	size_t count = 0;
+	size_t next = 0;
+	size_t remaining = 0;
+	uint64_t batch = 0;
+	bool stopping = false;
+};
+
+} //namespace SBX
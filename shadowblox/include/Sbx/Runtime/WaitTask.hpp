@@ -24,21 +24,55 @@ namespace SBX {
 
 class WaitTask : public ScheduledTask {
 public:
-	WaitTask(lua_State *T, double duration, bool legacyThrottling);
+	WaitTask(lua_State *T, double startTime, double duration, bool legacyThrottling);
 
 	bool CanThrottle() override { return legacyThrottling; }
 	bool IsComplete(ResumptionPoint /*point*/) override;
 	int PushResults() override;
-	void Update(uint64_t frame, double delta) override;
+
+	double GetWakeTime() const { return startTime + duration; }
+	// Called by the scheduler with its clock once the wake time has passed
+	void SetTime(uint64_t frame, double time);
 
 private:
+	double startTime;
 	double elapsed;
 	double duration;
 	uint64_t lastFrame;
 	bool legacyThrottling;
 };
 
+// Resumes a thread with arguments already on its stack (task.delay)
+class DelayTask : public WaitTask {
+public:
+	DelayTask(lua_State *T, double startTime, double duration, int nargs);
+
+	int PushResults() override { return nargs; }
+
+private:
+	int nargs;
+};
+
+// Resumes a thread with arguments already on its stack at the next
+// resumption point (task.defer)
+class DeferTask : public ScheduledTask {
+public:
+	DeferTask(lua_State *T, int nargs);
+
+	bool IsComplete(ResumptionPoint /*point*/) override { return true; }
+	int PushResults() override { return nargs; }
+
+private:
+	int nargs;
+};
+
 int luaSBX_wait(lua_State *L);
 int luaSBX_taskwait(lua_State *L);
+int luaSBX_taskspawn(lua_State *L);
+int luaSBX_taskdefer(lua_State *L);
+int luaSBX_taskdelay(lua_State *L);
+int luaSBX_taskcancel(lua_State *L);
+int luaSBX_taskdesynchronize(lua_State *L);
+int luaSBX_tasksynchronize(lua_State *L);
 
 } //namespace SBX
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace SBX {
+
+#define WATCHDOG_PERIOD_MS 5
+
+/**
+ * @brief A background thread which advances a coarse clock for script
+ * timeouts.
+ *
+ * Timeout checks run on every interrupt, so reading the clock must be cheap.
+ * While any watchdog runs, @ref Now reads its last tick instead of the system
+ * clock. Timeouts are then detected up to one period late.
+ */
+class Watchdog {
+public:
+	explicit Watchdog(uint32_t periodMs = WATCHDOG_PERIOD_MS);
+	~Watchdog();
+
+	Watchdog(const Watchdog &other) = delete;
+	Watchdog(Watchdog &&other) = delete;
+	Watchdog &operator=(const Watchdog &other) = delete;
+	Watchdog &operator=(Watchdog &&other) = delete;
+
+	/**
+	 * @brief Get the current time in milliseconds, for timeout deadlines.
+	 *
+	 * Coarse while a watchdog runs, and read from the system clock otherwise.
+	 */
+	static uint64_t Now() {
+		if (IsRunning()) {
+			return tick.load(std::memory_order_relaxed);
+		}
+
+		return ReadClock();
+	}
+
+	static bool IsRunning() { return active.load(std::memory_order_relaxed) > 0; }
+
+private:
+	static uint64_t ReadClock();
+	void Run();
+
+	static std::atomic<uint64_t> tick;
+	static std::atomic<int> active;
+
+	uint32_t periodMs;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stopping = false;
+	std::thread thread;
+};
+
+} //namespace SBX
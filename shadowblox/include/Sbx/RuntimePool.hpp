@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lua.h"
+
+namespace SBX {
+class LuauRuntime;
+}
+
+namespace SBX::Classes {
+class DataModel;
+}
+
+namespace SBX {
+
+/**
+ * @brief A runtime with its DataModel registered in the user VM.
+ */
+struct PooledRuntime {
+	std::unique_ptr<LuauRuntime> runtime;
+	std::shared_ptr<Classes::DataModel> dataModel;
+
+	~PooledRuntime();
+};
+
+/**
+ * @brief Keeps runtimes and DataModels initialized ahead of time, so that
+ * starting a match does not wait on VM creation.
+ *
+ * A background thread refills the pool and destroys released runtimes. VMs
+ * cannot be reset in place, so each released runtime is replaced by a new
+ * one.
+ *
+ * The first runtime is created on the constructing thread, so that class
+ * metatables and other shared state initialized on first use are set up
+ * before the background thread starts. The pool can then freeze that state,
+ * so that it is never written while the thread reads it.
+ */
+class RuntimePool {
+public:
+	/**
+	 * @param size The number of runtimes to keep ready.
+	 * @param initCallback The callback for each VM, as for @ref LuauRuntime.
+	 * @param debug Whether to enable the interrupt callback (and timeouts).
+	 * @param slabAllocator Whether VMs use slab allocators.
+	 * @param freezeSharedState Whether to freeze the class database and atoms
+	 * after creating the first runtime, until the pool's thread has stopped.
+	 */
+	RuntimePool(size_t size, void (*initCallback)(lua_State *), bool debug = false, bool slabAllocator = false, bool freezeSharedState = false);
+	~RuntimePool();
+
+	RuntimePool(const RuntimePool &other) = delete;
+	RuntimePool(RuntimePool &&other) = delete;
+	RuntimePool &operator=(const RuntimePool &other) = delete;
+	RuntimePool &operator=(RuntimePool &&other) = delete;
+
+	/**
+	 * @brief Take a ready runtime, or create one if none is ready.
+	 */
+	std::unique_ptr<PooledRuntime> Acquire();
+
+	/**
+	 * @brief Return a runtime to be destroyed in the background.
+	 *
+	 * Tasks of its VMs are cancelled and their logger and scheduler are
+	 * detached on the calling thread, since those belong to the host.
+	 */
+	void Release(std::unique_ptr<PooledRuntime> entry);
+
+	size_t NumReady() const;
+
+	/**
+	 * @brief Get the bytes reserved for slab allocator pages by the ready
+	 * runtimes.
+	 *
+	 * Acquired runtimes are accounted by their host with
+	 * @ref LuauRuntime::GetPageBytes.
+	 */
+	size_t GetPageBytes() const;
+
+private:
+	std::unique_ptr<PooledRuntime> Create() const;
+	void Run();
+
+	size_t size;
+	void (*initCallback)(lua_State *);
+	bool debug;
+	bool slabAllocator;
+	bool freezeSharedState;
+
+	mutable std::mutex mutex;
+	std::condition_variable wake;
+	std::vector<std::unique_ptr<PooledRuntime>> ready;
+	std::vector<std::unique_ptr<PooledRuntime>> released;
+	bool stopping = false;
+
+	std::thread thread;
+};
+
+} //namespace SBX
@@ -14,21 +14,35 @@
 
 #include "Sbx/Classes/ClassDB.hpp"
 
+#include <atomic>
+#include <cassert>
+#include <cstdio>
 #include <memory>
 #include <string_view>
 #include <vector>
 
 #include "lua.h"
 
+#include "Sbx/Classes/Object.hpp"
+#include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/StringMap.hpp"
 
 namespace SBX::Classes {
 
 StringMap<ClassDB::ClassInfo> ClassDB::classes;
+std::vector<ClassDB::ClassRange> ClassDB::classRanges;
 StringMap<std::shared_ptr<Object> (*)()> ClassDB::constructors;
 std::vector<void (*)(lua_State *)> ClassDB::registerCallbacks;
+std::atomic<int> ClassDB::freezeCount = 0;
+
+void ClassDB::ReportFrozenClass(const char *className) {
+	fprintf(stderr, "ClassDB: %s was initialized after the class database was frozen, and is not registered\n", className);
+	assert(!"class initialized while the class database is frozen");
+}
 
 void ClassDB::Register(lua_State *L) {
+	lua_setuserdatadtor(L, ObjectUdata, luaSBX_objectdtor);
+
 	for (auto cb : registerCallbacks) {
 		cb(L);
 	}
@@ -99,26 +113,51 @@ const ClassDB::Callback *ClassDB::GetCallback(std::string_view className, std::s
 	return &cb->second;
 }
 
-std::shared_ptr<Object> ClassDB::New(std::string_view className) {
-	auto ctor = constructors.find(className);
-	return ctor != constructors.end() ? ctor->second() : nullptr;
+int ClassDB::GetClassId(std::string_view className) {
+	auto c = classes.find(className);
+	return c != classes.end() ? c->second.id : -1;
 }
 
-bool ClassDB::IsA(std::string_view derived, std::string_view base) {
-	if (!classes.contains(base)) {
-		return false;
+void ClassDB::UpdateClassRanges() {
+	// Classes whose parent is not registered (yet) are treated as roots
+	StringMap<std::vector<const ClassInfo *>> children;
+	std::vector<const ClassInfo *> roots;
+
+	for (const auto &[name, info] : classes) {
+		if (classes.contains(info.parent)) {
+			children[info.parent].push_back(&info);
+		} else {
+			roots.push_back(&info);
+		}
 	}
 
-	std::string_view curr = derived;
-	while (!curr.empty()) {
-		if (curr == base) {
-			return true;
+	int position = 0;
+	auto visit = [&](auto &self, const ClassInfo *info) -> void {
+		ClassRange &range = classRanges[info->id];
+		range.first = position++;
+
+		auto it = children.find(info->name);
+		if (it != children.end()) {
+			for (const ClassInfo *child : it->second) {
+				self(self, child);
+			}
 		}
 
-		curr = classes.find(curr)->second.parent;
+		range.last = position - 1;
+	};
+
+	for (const ClassInfo *root : roots) {
+		visit(visit, root);
 	}
+}
 
-	return false;
+std::shared_ptr<Object> ClassDB::New(std::string_view className) {
+	auto ctor = constructors.find(className);
+	return ctor != constructors.end() ? ctor->second() : nullptr;
+}
+
+bool ClassDB::IsA(std::string_view derived, std::string_view base) {
+	return IsA(GetClassId(derived), GetClassId(base));
 }
 
 } //namespace SBX::Classes
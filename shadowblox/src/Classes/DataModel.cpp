@@ -154,18 +154,15 @@ int DataModel::FindServiceLuau(lua_State *L) {
 	return 1;
 }
 
-int DataModel::WorkspaceIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Workspace") == 0) {
-		DataModel *self = LuauStackOp<DataModel *>::Check(L, 1);
-		std::shared_ptr<Workspace> ws = self->GetWorkspace();
-		if (ws) {
-			LuauStackOp<std::shared_ptr<Instance>>::Push(L, ws);
-		} else {
-			lua_pushnil(L);
-		}
-		return 1;
+int DataModel::GetWorkspaceLuau(lua_State *L) {
+	DataModel *self = LuauStackOp<DataModel *>::Check(L, 1);
+	std::shared_ptr<Workspace> ws = self->GetWorkspace();
+	if (ws) {
+		LuauStackOp<std::shared_ptr<Instance>>::Push(L, ws);
+	} else {
+		lua_pushnil(L);
 	}
-	return 0;  // Not handled
+	return 1;
 }
 
 } // namespace SBX::Classes
@@ -14,8 +14,6 @@
 
 #include "Sbx/Classes/Humanoid.hpp"
 
-#include <cstring>
-
 #include "lua.h"
 
 #include "Sbx/Classes/Part.hpp"
@@ -41,11 +39,11 @@ void Humanoid::SetHealth(double value) {
 	}
 
 	if (health != oldHealth) {
-		Emit<Humanoid>("HealthChanged", health);
+		Emit<Humanoid, "HealthChanged">(health);
 		Changed<Humanoid>("Health");
 
 		if (health <= 0 && oldHealth > 0) {
-			Emit<Humanoid>("Died");
+			Emit<Humanoid, "Died">();
 		}
 	}
 }
@@ -83,7 +81,7 @@ void Humanoid::SetJump(bool value) {
 	bool wasJumping = jump;
 	jump = value;
 	if (jump && !wasJumping) {
-		Emit<Humanoid>("Jumping", true);
+		Emit<Humanoid, "Jumping">(true);
 	}
 	Changed<Humanoid>("Jump");
 }
@@ -154,11 +152,4 @@ int Humanoid::GetMoveDirectionLuau(lua_State *L) {
 	return 1;
 }
 
-int Humanoid::HumanoidIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "MoveDirection") == 0) {
-		return GetMoveDirectionLuau(L);
-	}
-	return 0;
-}
-
 } // namespace SBX::Classes
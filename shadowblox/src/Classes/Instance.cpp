@@ -19,6 +19,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "lua.h"
@@ -47,11 +48,11 @@ const char *Instance::GetName() const {
 	return name.c_str();
 }
 
-void Instance::SetName(const char *newName) {
+void Instance::SetName(std::string_view newName) {
 	if (destroyed) {
 		return;
 	}
-	name = newName ? newName : "";
+	name.assign(newName);
 	Changed<Instance>("Name");
 }
 
@@ -105,7 +106,7 @@ void Instance::AddChild(std::shared_ptr<Instance> child) {
 	}
 
 	children.push_back(child);
-	Emit<Instance>("ChildAdded", child);
+	Emit<Instance, "ChildAdded">(child);
 	EmitDescendantAdded(child);
 
 	// Also emit DescendantAdded for all descendants of the child
@@ -134,7 +135,7 @@ void Instance::RemoveChild(Instance *child) {
 		EmitDescendantRemoving(childPtr);
 
 		children.erase(it);
-		Emit<Instance>("ChildRemoved", childPtr);
+		Emit<Instance, "ChildRemoved">(childPtr);
 	}
 }
 
@@ -156,9 +157,9 @@ void Instance::CollectDescendants(std::vector<std::shared_ptr<Instance>> &result
 	}
 }
 
-std::shared_ptr<Instance> Instance::FindFirstChild(const char *searchName, bool recursive) const {
+std::shared_ptr<Instance> Instance::FindFirstChild(std::string_view searchName, bool recursive) const {
 	for (const auto &child : children) {
-		if (std::strcmp(child->GetName(), searchName) == 0) {
+		if (child->name == searchName) {
 			return child;
 		}
 		if (recursive) {
@@ -186,10 +187,10 @@ std::shared_ptr<Instance> Instance::FindFirstChildOfClass(const char *className,
 	return nullptr;
 }
 
-std::shared_ptr<Instance> Instance::FindFirstAncestor(const char *searchName) const {
+std::shared_ptr<Instance> Instance::FindFirstAncestor(std::string_view searchName) const {
 	std::shared_ptr<Instance> p = parent.lock();
 	while (p) {
-		if (std::strcmp(p->GetName(), searchName) == 0) {
+		if (p->name == searchName) {
 			return p;
 		}
 		p = p->GetParent();
@@ -209,9 +210,14 @@ std::shared_ptr<Instance> Instance::FindFirstAncestorOfClass(const char *classNa
 }
 
 std::shared_ptr<Instance> Instance::FindFirstAncestorWhichIsA(const char *className) const {
+	const int classId = ClassDB::GetClassId(className);
+	if (classId < 0) {
+		return nullptr;
+	}
+
 	std::shared_ptr<Instance> p = parent.lock();
 	while (p) {
-		if (p->IsA(className)) {
+		if (ClassDB::IsA(p->GetClassId(), classId)) {
 			return p;
 		}
 		p = p->GetParent();
@@ -220,12 +226,21 @@ std::shared_ptr<Instance> Instance::FindFirstAncestorWhichIsA(const char *classN
 }
 
 std::shared_ptr<Instance> Instance::FindFirstChildWhichIsA(const char *className, bool recursive) const {
+	const int classId = ClassDB::GetClassId(className);
+	if (classId < 0) {
+		return nullptr;
+	}
+
+	return FindFirstChildWhichIsAById(classId, recursive);
+}
+
+std::shared_ptr<Instance> Instance::FindFirstChildWhichIsAById(int classId, bool recursive) const {
 	for (const auto &child : children) {
-		if (child->IsA(className)) {
+		if (ClassDB::IsA(child->GetClassId(), classId)) {
 			return child;
 		}
 		if (recursive) {
-			auto found = child->FindFirstChildWhichIsA(className, true);
+			auto found = child->FindFirstChildWhichIsAById(classId, true);
 			if (found) {
 				return found;
 			}
@@ -284,7 +299,7 @@ void Instance::Destroy() {
 	}
 
 	destroyed = true;
-	Emit<Instance>("Destroying");
+	Emit<Instance, "Destroying">();
 
 	// Clear all children first
 	ClearAllChildren();
@@ -308,7 +323,7 @@ void Instance::ClearAllChildren() {
 
 // Signal helpers
 void Instance::EmitDescendantAdded(std::shared_ptr<Instance> descendant) {
-	Emit<Instance>("DescendantAdded", descendant);
+	Emit<Instance, "DescendantAdded">(descendant);
 
 	std::shared_ptr<Instance> p = parent.lock();
 	if (p) {
@@ -317,7 +332,7 @@ void Instance::EmitDescendantAdded(std::shared_ptr<Instance> descendant) {
 }
 
 void Instance::EmitDescendantRemoving(std::shared_ptr<Instance> descendant) {
-	Emit<Instance>("DescendantRemoving", descendant);
+	Emit<Instance, "DescendantRemoving">(descendant);
 
 	std::shared_ptr<Instance> p = parent.lock();
 	if (p) {
@@ -326,7 +341,7 @@ void Instance::EmitDescendantRemoving(std::shared_ptr<Instance> descendant) {
 }
 
 void Instance::EmitAncestryChanged(std::shared_ptr<Instance> child, std::shared_ptr<Instance> newParent) {
-	Emit<Instance>("AncestryChanged", child, newParent);
+	Emit<Instance, "AncestryChanged">(child, newParent);
 
 	// Also emit for all descendants
 	for (const auto &c : children) {
@@ -334,34 +349,28 @@ void Instance::EmitAncestryChanged(std::shared_ptr<Instance> child, std::shared_
 	}
 }
 
-// Custom index/newindex overrides for Parent property
-int Instance::ParentIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Parent") == 0) {
-		Instance *self = LuauStackOp<Instance *>::Check(L, 1);
-		std::shared_ptr<Instance> p = self->GetParent();
-		if (p) {
-			LuauStackOp<std::shared_ptr<Instance>>::Push(L, p);
-		} else {
-			lua_pushnil(L);
-		}
-		return 1;
+// Custom Luau accessors for Parent property
+int Instance::GetParentLuau(lua_State *L) {
+	Instance *self = LuauStackOp<Instance *>::Check(L, 1);
+	std::shared_ptr<Instance> p = self->GetParent();
+	if (p) {
+		LuauStackOp<std::shared_ptr<Instance>>::Push(L, p);
+	} else {
+		lua_pushnil(L);
 	}
-	return 0; // Not handled
+	return 1;
 }
 
-bool Instance::ParentNewindexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Parent") == 0) {
-		Instance *self = LuauStackOp<Instance *>::Check(L, 1);
-
-		std::shared_ptr<Instance> newParent;
-		if (!lua_isnil(L, 3)) {
-			newParent = LuauStackOp<std::shared_ptr<Instance>>::Check(L, 3);
-		}
+int Instance::SetParentLuau(lua_State *L) {
+	Instance *self = LuauStackOp<Instance *>::Check(L, 1);
 
-		self->SetParent(newParent);
-		return true;
+	std::shared_ptr<Instance> newParent;
+	if (!lua_isnil(L, 2)) {
+		newParent = LuauStackOp<std::shared_ptr<Instance>>::Check(L, 2);
 	}
-	return false; // Not handled
+
+	self->SetParent(newParent);
+	return 0;
 }
 
 // Luau method implementations
@@ -391,7 +400,7 @@ int Instance::GetDescendantsLuau(lua_State *L) {
 
 int Instance::FindFirstChildLuau(lua_State *L) {
 	Instance *self = LuauStackOp<Instance *>::Check(L, 1);
-	const char *searchName = luaL_checkstring(L, 2);
+	std::string_view searchName = LuauStackOp<std::string_view>::Check(L, 2);
 	bool recursive = lua_isboolean(L, 3) ? lua_toboolean(L, 3) : false;
 
 	std::shared_ptr<Instance> result = self->FindFirstChild(searchName, recursive);
@@ -419,7 +428,7 @@ int Instance::FindFirstChildOfClassLuau(lua_State *L) {
 
 int Instance::FindFirstAncestorLuau(lua_State *L) {
 	Instance *self = LuauStackOp<Instance *>::Check(L, 1);
-	const char *searchName = luaL_checkstring(L, 2);
+	std::string_view searchName = LuauStackOp<std::string_view>::Check(L, 2);
 
 	std::shared_ptr<Instance> result = self->FindFirstAncestor(searchName);
 	if (result) {
@@ -15,7 +15,6 @@
 #include "Sbx/Classes/Model.hpp"
 
 #include <algorithm>
-#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -140,8 +139,8 @@ int Model::GetPrimaryPartLuau(lua_State *L) {
 int Model::SetPrimaryPartLuau(lua_State *L) {
 	Model *self = LuauStackOp<Model *>::Check(L, 1);
 	std::shared_ptr<Part> part;
-	if (!lua_isnil(L, 3)) {
-		part = LuauStackOp<std::shared_ptr<Part>>::Check(L, 3);
+	if (!lua_isnil(L, 2)) {
+		part = LuauStackOp<std::shared_ptr<Part>>::Check(L, 2);
 	}
 	self->SetPrimaryPart(part);
 	return 0;
@@ -167,20 +166,4 @@ int Model::TranslateByLuau(lua_State *L) {
 	return 0;
 }
 
-// Custom index/newindex overrides for PrimaryPart property
-int Model::ModelIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "PrimaryPart") == 0) {
-		return GetPrimaryPartLuau(L);
-	}
-	return 0; // Not handled
-}
-
-bool Model::ModelNewindexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "PrimaryPart") == 0) {
-		SetPrimaryPartLuau(L);
-		return true;
-	}
-	return false; // Not handled
-}
-
 } //namespace SBX::Classes
@@ -28,7 +28,8 @@
 // clang-format on
 /* BEGIN USER CODE PreNamespace */
 #include <memory>
-#include <string>
+#include <utility>
+#include <vector>
 
 #include "lualib.h"
 
@@ -43,9 +44,7 @@ namespace SBX::Classes {
 
 // clang-format on
 /* BEGIN USER CODE PreClass */
-Object::Object() :
-		emitter(std::make_shared<SignalEmitter>()) {
-}
+Object::Object() {}
 /* END USER CODE PreClass */
 // clang-format off
 
@@ -56,12 +55,12 @@ int Object::GetPropertyChangedSignal(lua_State *L) {
 	const char *propName = lua_tostring(L, 2);
 
 	const ClassDB::Property *prop = ClassDB::GetProperty(self->GetClassName(), propName);
-	if (!prop || prop->changedSignal.empty()) {
+	if (!prop || prop->changedSignalId < 0) {
 		luaL_error(L, "%s is not a valid property name.", propName);
 	}
 
 	luaSBX_checkcapability(L, prop->readSecurity, "read", propName);
-	self->PushSignal(L, prop->changedSignal, prop->readSecurity);
+	self->PushSignal(L, 1, prop->changedSignalId, prop->readSecurity);
 	return 1;
 	/* END USER CODE MethodGetPropertyChangedSignal */
 	// clang-format off
@@ -70,15 +69,157 @@ int Object::GetPropertyChangedSignal(lua_State *L) {
 bool Object::IsA(const char *className) const {
 	// clang-format on
 	/* BEGIN USER CODE MethodIsA */
-	return ClassDB::IsA(GetClassName(), className);
+	return ClassDB::IsA(GetClassId(), ClassDB::GetClassId(className));
 	/* END USER CODE MethodIsA */
 	// clang-format off
 }
 
 // clang-format on
 /* BEGIN USER CODE PostClass */
-void Object::PushSignal(lua_State *L, std::string_view name, SbxCapability security) {
-	LuauStackOp<DataTypes::RBXScriptSignal>::Push(L, DataTypes::RBXScriptSignal(emitter, std::string(name), security));
+void Object::PushSignal(lua_State *L, int objIndex, int signal, SbxCapability security) {
+	objIndex = lua_absindex(L, objIndex);
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+
+	lua_getref(L, udata->signalCache);
+	lua_pushvalue(L, objIndex);
+	lua_rawget(L, -2);
+
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1); // nil
+
+		lua_newtable(L);
+		lua_pushvalue(L, objIndex);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, -4);
+	}
+
+	lua_remove(L, -2); // cache
+	lua_rawgeti(L, -1, signal + 1);
+
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1); // nil
+
+		std::shared_ptr<SignalEmitter> signalEmitter;
+		{
+			LuauLock lock(*this);
+			if (!emitter) {
+				emitter = std::make_shared<SignalEmitter>();
+			}
+
+			signalEmitter = emitter;
+		}
+
+		LuauStackOp<DataTypes::RBXScriptSignal>::Push(L, DataTypes::RBXScriptSignal(signalEmitter, signal, security));
+		lua_pushvalue(L, -1);
+		lua_rawseti(L, -3, signal + 1);
+	}
+
+	lua_remove(L, -2); // object's signals
+}
+
+void luaSBX_newobject(lua_State *L, const std::shared_ptr<Object> &object) {
+	const int classId = object->GetClassId();
+
+	ObjectUserdata *udata = reinterpret_cast<ObjectUserdata *>(lua_newuserdatatagged(L, sizeof(ObjectUserdata), ObjectUdata));
+	new (udata) ObjectUserdata{ object, classId };
+
+	if (!luaSBX_pushclassmetatable(L, classId)) {
+		luaL_error(L, "metatable for object %s missing", object->GetClassName());
+	}
+
+	lua_setmetatable(L, -2);
+}
+
+Object::LuauHandle *Object::FindLuauHandle(const SbxGlobalThreadData *vm) {
+	for (LuauHandle &h : luauHandles) {
+		if (h.vm == vm) {
+			return &h;
+		}
+	}
+
+	return nullptr;
+}
+
+void luaSBX_pushobject(lua_State *L, const std::shared_ptr<Object> &object) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	SbxGlobalThreadData *global = udata->global;
+
+	// Handles may be added or removed by other VMs in the parallel phase, so
+	// they are only accessed under the lock, and never across allocations
+	int slot = 0;
+	{
+		Object::LuauLock lock(*object);
+		if (Object::LuauHandle *handle = object->FindLuauHandle(global)) {
+			slot = handle->slot;
+		}
+	}
+
+	lua_getref(L, udata->weakObjRegistry);
+
+	if (slot) {
+		lua_rawgeti(L, -1, slot);
+
+		if (!lua_isnil(L, -1)) {
+			lua_remove(L, -2); // table
+			return;
+		}
+
+		// Collected, but the destructor has not run yet. Detach it so it does
+		// not release the slot (it may run while allocating below).
+		lua_pop(L, 1);
+
+		Object::LuauLock lock(*object);
+		object->FindLuauHandle(global)->udata = nullptr;
+	} else {
+		if (global->freeObjSlots.empty()) {
+			slot = ++global->objSlotCount;
+		} else {
+			slot = global->freeObjSlots.back();
+			global->freeObjSlots.pop_back();
+		}
+
+		Object::LuauLock lock(*object);
+		Object::LuauHandle &handle = object->luauHandles.emplace_back();
+		handle.vm = global;
+		handle.slot = slot;
+	}
+
+	luaSBX_newobject(L, object);
+
+	{
+		Object::LuauLock lock(*object);
+		object->FindLuauHandle(global)->udata = lua_touserdata(L, -1);
+	}
+
+	lua_pushvalue(L, -1);
+	lua_rawseti(L, -3, slot);
+	lua_remove(L, -2); // table
+}
+
+void luaSBX_objectdtor(lua_State *L, void *udata) {
+	ObjectUserdata *objUdata = reinterpret_cast<ObjectUserdata *>(udata);
+	SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+
+	{
+		Object::LuauLock lock(*objUdata->object);
+		std::vector<Object::LuauHandle> &handles = objUdata->object->luauHandles;
+
+		// The handle may have already moved on to a newer userdata
+		for (auto it = handles.begin(); it != handles.end(); ++it) {
+			if (it->udata == udata) {
+				global->freeObjSlots.push_back(it->slot);
+				handles.erase(it);
+				break;
+			}
+		}
+	}
+
+	if (global->parallelPhase) {
+		// Destruction may touch other VMs, so wait until the phase ends
+		global->parallelReleases.push_back(std::move(objUdata->object));
+	}
+
+	objUdata->~ObjectUserdata();
 }
 /* END USER CODE PostClass */
 // clang-format off
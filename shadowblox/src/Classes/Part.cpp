@@ -15,7 +15,6 @@
 #include "Sbx/Classes/Part.hpp"
 
 #include <algorithm>
-#include <cstring>
 
 #include "lua.h"
 
@@ -72,7 +71,7 @@ int Part::GetSizeLuau(lua_State *L) {
 
 int Part::SetSizeLuau(lua_State *L) {
 	Part *self = LuauStackOp<Part *>::Check(L, 1);
-	DataTypes::Vector3 newSize = LuauStackOp<DataTypes::Vector3>::Check(L, 3);
+	DataTypes::Vector3 newSize = LuauStackOp<DataTypes::Vector3>::Check(L, 2);
 	self->SetSize(newSize);
 	return 0;
 }
@@ -85,43 +84,20 @@ int Part::GetPositionLuau(lua_State *L) {
 
 int Part::SetPositionLuau(lua_State *L) {
 	Part *self = LuauStackOp<Part *>::Check(L, 1);
-	DataTypes::Vector3 newPosition = LuauStackOp<DataTypes::Vector3>::Check(L, 3);
+	DataTypes::Vector3 newPosition = LuauStackOp<DataTypes::Vector3>::Check(L, 2);
 	self->SetPosition(newPosition);
 	return 0;
 }
 
-// Custom index/newindex overrides for Vector3 properties
-int Part::PartIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Size") == 0) {
-		return GetSizeLuau(L);
-	}
-	if (std::strcmp(propName, "Position") == 0) {
-		return GetPositionLuau(L);
-	}
-	return 0; // Not handled
-}
-
-bool Part::PartNewindexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Size") == 0) {
-		SetSizeLuau(L);
-		return true;
-	}
-	if (std::strcmp(propName, "Position") == 0) {
-		SetPositionLuau(L);
-		return true;
-	}
-	return false; // Not handled
-}
-
 void Part::FireTouched(std::shared_ptr<Part> otherPart) {
 	if (canTouch && otherPart && otherPart->GetCanTouch()) {
-		Emit<Part>("Touched", otherPart);
+		Emit<Part, "Touched">(otherPart);
 	}
 }
 
 void Part::FireTouchEnded(std::shared_ptr<Part> otherPart) {
 	if (canTouch && otherPart && otherPart->GetCanTouch()) {
-		Emit<Part>("TouchEnded", otherPart);
+		Emit<Part, "TouchEnded">(otherPart);
 	}
 }
 
@@ -14,8 +14,6 @@
 
 #include "Sbx/Classes/Player.hpp"
 
-#include <cstring>
-
 #include "lua.h"
 
 #include "Sbx/Classes/Model.hpp"
@@ -35,14 +33,14 @@ void Player::SetCharacter(std::shared_ptr<Model> model) {
 	}
 
 	if (oldCharacter) {
-		Emit<Player>("CharacterRemoving", oldCharacter);
+		Emit<Player, "CharacterRemoving">(oldCharacter);
 	}
 
 	character = model;
 	Changed<Player>("Character");
 
 	if (model) {
-		Emit<Player>("CharacterAdded", model);
+		Emit<Player, "CharacterAdded">(model);
 	}
 }
 
@@ -74,28 +72,13 @@ int Player::GetCharacterLuau(lua_State *L) {
 
 int Player::SetCharacterLuau(lua_State *L) {
 	Player *self = LuauStackOp<Player *>::Check(L, 1);
-	if (lua_isnil(L, 3)) {
+	if (lua_isnil(L, 2)) {
 		self->SetCharacter(nullptr);
 	} else {
-		std::shared_ptr<Model> model = LuauStackOp<std::shared_ptr<Model>>::Check(L, 3);
+		std::shared_ptr<Model> model = LuauStackOp<std::shared_ptr<Model>>::Check(L, 2);
 		self->SetCharacter(model);
 	}
 	return 0;
 }
 
-int Player::PlayerIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Character") == 0) {
-		return GetCharacterLuau(L);
-	}
-	return 0; // Not handled
-}
-
-bool Player::PlayerNewindexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Character") == 0) {
-		SetCharacterLuau(L);
-		return true;
-	}
-	return false; // Not handled
-}
-
 } // namespace SBX::Classes
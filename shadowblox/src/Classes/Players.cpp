@@ -14,8 +14,6 @@
 
 #include "Sbx/Classes/Players.hpp"
 
-#include <cstring>
-
 #include "lua.h"
 
 #include "Sbx/Classes/Model.hpp"
@@ -95,7 +93,7 @@ std::shared_ptr<Player> Players::CreateLocalPlayer(int64_t userId, const char *d
 	playersByUserId[userId] = player;
 	localPlayer = player;
 
-	Emit<Players>("PlayerAdded", player);
+	Emit<Players, "PlayerAdded">(player);
 
 	return player;
 }
@@ -118,7 +116,7 @@ std::shared_ptr<Player> Players::AddPlayer(int64_t userId, const char *displayNa
 
 	playersByUserId[userId] = player;
 
-	Emit<Players>("PlayerAdded", player);
+	Emit<Players, "PlayerAdded">(player);
 
 	return player;
 }
@@ -128,7 +126,7 @@ void Players::RemovePlayer(std::shared_ptr<Player> player) {
 		return;
 	}
 
-	Emit<Players>("PlayerRemoving", player);
+	Emit<Players, "PlayerRemoving">(player);
 
 	playersByUserId.erase(player->GetUserId());
 
@@ -195,11 +193,4 @@ int Players::GetLocalPlayerLuau(lua_State *L) {
 	return 1;
 }
 
-int Players::PlayersIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "LocalPlayer") == 0) {
-		return GetLocalPlayerLuau(L);
-	}
-	return 0; // Not handled
-}
-
 } // namespace SBX::Classes
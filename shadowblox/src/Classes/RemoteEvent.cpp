@@ -22,6 +22,7 @@
 #include "Sbx/Classes/DataModel.hpp"
 #include "Sbx/Classes/Player.hpp"
 #include "Sbx/Classes/RunService.hpp"
+#include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/Stack.hpp"
 
 namespace SBX::Classes {
@@ -41,6 +42,11 @@ NetworkEventCallback RemoteEvent::GetNetworkCallback() {
 	return networkCallback;
 }
 
+static const NetworkEventCallback &luaSBX_eventcallback(lua_State *L, const NetworkEventCallback &fallback) {
+	const NetworkEventCallback &callback = luaSBX_getthreaddata(L)->global->networkEventCallback;
+	return callback ? callback : fallback;
+}
+
 // Serialization format:
 // [type:1][data:variable]
 // Types: 0=nil, 1=bool, 2=number, 3=string, 4=table(array), 5=Instance
@@ -280,34 +286,37 @@ void RemoteEvent::FireClient(std::shared_ptr<Player> player, lua_State *L, int a
 		return;
 	}
 
-	if (networkCallback) {
+	const NetworkEventCallback &callback = luaSBX_eventcallback(L, networkCallback);
+	if (callback) {
 		auto data = SerializeArgs(L, argStart, argCount);
-		networkCallback(GetName(), player->GetUserId(), data);
+		callback(GetName(), player->GetUserId(), data);
 	}
 }
 
 void RemoteEvent::FireAllClients(lua_State *L, int argStart, int argCount) {
-	if (networkCallback) {
+	const NetworkEventCallback &callback = luaSBX_eventcallback(L, networkCallback);
+	if (callback) {
 		auto data = SerializeArgs(L, argStart, argCount);
-		networkCallback(GetName(), -1, data); // -1 means all clients
+		callback(GetName(), -1, data); // -1 means all clients
 	}
 }
 
 void RemoteEvent::FireServer(lua_State *L, int argStart, int argCount) {
-	if (networkCallback) {
+	const NetworkEventCallback &callback = luaSBX_eventcallback(L, networkCallback);
+	if (callback) {
 		auto data = SerializeArgs(L, argStart, argCount);
-		networkCallback(GetName(), 0, data); // 0 means server
+		callback(GetName(), 0, data); // 0 means server
 	}
 }
 
 void RemoteEvent::OnServerEvent(std::shared_ptr<Player> player, lua_State *L, const std::vector<uint8_t> &data) {
 	// Push event args and emit signal
-	Emit<RemoteEvent>("OnServerEvent", player);
+	Emit<RemoteEvent, "OnServerEvent">(player);
 }
 
 void RemoteEvent::OnClientEvent(lua_State *L, const std::vector<uint8_t> &data) {
 	// Emit the OnClientEvent signal
-	Emit<RemoteEvent>("OnClientEvent");
+	Emit<RemoteEvent, "OnClientEvent">();
 }
 
 int RemoteEvent::FireClientLuau(lua_State *L) {
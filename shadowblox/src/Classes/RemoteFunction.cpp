@@ -20,6 +20,7 @@
 #include "lualib.h"
 
 #include "Sbx/Classes/Player.hpp"
+#include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/Stack.hpp"
 
 namespace SBX::Classes {
@@ -39,6 +40,11 @@ NetworkFunctionCallback RemoteFunction::GetNetworkCallback() {
 	return networkCallback;
 }
 
+static const NetworkFunctionCallback &luaSBX_functioncallback(lua_State *L, const NetworkFunctionCallback &fallback) {
+	const NetworkFunctionCallback &callback = luaSBX_getthreaddata(L)->global->networkFunctionCallback;
+	return callback ? callback : fallback;
+}
+
 // Reuse the same serialization format as RemoteEvent
 enum class SerialType : uint8_t {
 	Nil = 0,
@@ -191,9 +197,10 @@ int RemoteFunction::DeserializeArgs(lua_State *L, const std::vector<uint8_t> &da
 int RemoteFunction::InvokeServer(lua_State *L) {
 	int argCount = lua_gettop(L) - 1;
 
-	if (networkCallback) {
+	const NetworkFunctionCallback &callback = luaSBX_functioncallback(L, networkCallback);
+	if (callback) {
 		auto data = SerializeArgs(L, 2, argCount);
-		auto response = networkCallback(GetName(), 0, data);
+		auto response = callback(GetName(), 0, data);
 		return DeserializeArgs(L, response);
 	}
 
@@ -208,9 +215,10 @@ int RemoteFunction::InvokeClient(std::shared_ptr<Player> player, lua_State *L) {
 
 	int argCount = lua_gettop(L) - 2;
 
-	if (networkCallback) {
+	const NetworkFunctionCallback &callback = luaSBX_functioncallback(L, networkCallback);
+	if (callback) {
 		auto data = SerializeArgs(L, 3, argCount);
-		auto response = networkCallback(GetName(), player->GetUserId(), data);
+		auto response = callback(GetName(), player->GetUserId(), data);
 		return DeserializeArgs(L, response);
 	}
 
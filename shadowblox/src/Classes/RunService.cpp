@@ -15,9 +15,13 @@
 #include "Sbx/Classes/RunService.hpp"
 
 #include "Sbx/Classes/ClassDB.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
 
 namespace SBX::Classes {
 
+// Seconds after which legacy wait() stops resuming threads in a frame
+#define LEGACY_WAIT_THROTTLE 0.01
+
 RunService::RunService() :
 		Instance() {
 	SetName("RunService");
@@ -55,10 +59,15 @@ void RunService::FireStepped(double time, double dt) {
 		return;
 	}
 
+	if (!inFrame) {
+		BeginFrame();
+	}
+
 	deltaTime = dt;
 	elapsedTime = time;
-	Emit<RunService>("Stepped", time, dt);
-	Emit<RunService>("PreSimulation", dt);
+	Emit<RunService, "Stepped">(time, dt);
+	Emit<RunService, "PreSimulation">(dt);
+	ResumeTasks(ResumptionPoint::PreSimulation, dt);
 }
 
 void RunService::FireHeartbeat(double dt) {
@@ -66,9 +75,16 @@ void RunService::FireHeartbeat(double dt) {
 		return;
 	}
 
+	if (!inFrame) {
+		BeginFrame();
+	}
+
 	deltaTime = dt;
-	Emit<RunService>("Heartbeat", dt);
-	Emit<RunService>("PostSimulation", dt);
+	Emit<RunService, "Heartbeat">(dt);
+	Emit<RunService, "PostSimulation">(dt);
+	ResumeTasks(ResumptionPoint::PostSimulation, dt);
+	ResumeTasks(ResumptionPoint::Wait, dt);
+	ResumeTasks(ResumptionPoint::Heartbeat, dt);
 }
 
 void RunService::FireRenderStepped(double dt) {
@@ -76,10 +92,50 @@ void RunService::FireRenderStepped(double dt) {
 		return;
 	}
 
+	if (!inFrame) {
+		BeginFrame();
+	}
+
 	deltaTime = dt;
-	Emit<RunService>("RenderStepped", dt);
-	Emit<RunService>("PreRender", dt);
-	Emit<RunService>("PreAnimation", dt);
+	Emit<RunService, "RenderStepped">(dt);
+	Emit<RunService, "PreRender">(dt);
+	ResumeTasks(ResumptionPoint::PreRender, dt);
+	ResumeTasks(ResumptionPoint::LegacyWait, dt);
+	Emit<RunService, "PreAnimation">(dt);
+	ResumeTasks(ResumptionPoint::PreAnimation, dt);
+}
+
+void RunService::StepFrame(double dt) {
+	if (!isRunning) {
+		return;
+	}
+
+	BeginFrame();
+	inFrame = true;
+
+	FireRenderStepped(dt);
+	FireStepped(elapsedTime + dt, dt);
+	FireHeartbeat(dt);
+
+	inFrame = false;
+}
+
+void RunService::BeginFrame() {
+	frame++;
+	frameResumed = false;
+}
+
+void RunService::ResumeTasks(ResumptionPoint point, double dt) {
+	if (!scheduler) {
+		return;
+	}
+
+	// The scheduler clock advances once per frame, at its first resumption
+	// point
+	double delta = frameResumed ? 0.0 : dt;
+	frameResumed = true;
+
+	scheduler->Resume(point, frame, delta, LEGACY_WAIT_THROTTLE);
 }
 
 void RunService::Pause() {
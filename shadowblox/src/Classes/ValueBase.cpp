@@ -14,8 +14,6 @@
 
 #include "Sbx/Classes/ValueBase.hpp"
 
-#include <cstring>
-
 #include "lua.h"
 
 #include "Sbx/Runtime/Stack.hpp"
@@ -96,28 +94,13 @@ int ObjectValue::GetValueLuau(lua_State *L) {
 
 int ObjectValue::SetValueLuau(lua_State *L) {
 	ObjectValue *self = LuauStackOp<ObjectValue *>::Check(L, 1);
-	if (lua_isnil(L, 3)) {
+	if (lua_isnil(L, 2)) {
 		self->SetValue(nullptr);
 	} else {
-		std::shared_ptr<Instance> val = LuauStackOp<std::shared_ptr<Instance>>::Check(L, 3);
+		std::shared_ptr<Instance> val = LuauStackOp<std::shared_ptr<Instance>>::Check(L, 2);
 		self->SetValue(val);
 	}
 	return 0;
 }
 
-int ObjectValue::ObjectValueIndexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Value") == 0) {
-		return GetValueLuau(L);
-	}
-	return 0;
-}
-
-bool ObjectValue::ObjectValueNewindexOverride(lua_State *L, const char *propName) {
-	if (std::strcmp(propName, "Value") == 0) {
-		SetValueLuau(L);
-		return true;
-	}
-	return false;
-}
-
 } // namespace SBX::Classes
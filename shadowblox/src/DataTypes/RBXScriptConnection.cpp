@@ -18,7 +18,6 @@
 
 #include <cstdint>
 #include <memory>
-#include <string>
 #include <utility>
 
 #include "Sbx/Runtime/Base.hpp"
@@ -29,11 +28,11 @@
 namespace SBX::DataTypes {
 
 RBXScriptConnection::RBXScriptConnection() :
-		id(0) {
+		signal(-1), id(0) {
 }
 
-RBXScriptConnection::RBXScriptConnection(std::shared_ptr<SignalEmitter> emitter, std::string name, uint64_t id) :
-		emitter(std::move(emitter)), name(std::move(name)), id(id) {
+RBXScriptConnection::RBXScriptConnection(std::shared_ptr<SignalEmitter> emitter, int signal, uint64_t id) :
+		emitter(std::move(emitter)), signal(signal), id(id) {
 }
 
 void RBXScriptConnection::Register(lua_State *L) {
@@ -43,7 +42,7 @@ void RBXScriptConnection::Register(lua_State *L) {
 		B::Init("RBXScriptConnection", "RBXScriptConnection", RBXScriptConnectionUdata);
 
 		B::BindPropertyReadOnly<"Connected", &RBXScriptConnection::IsConnected, NoneSecurity>();
-		B::BindMethod<"Disconnect", &RBXScriptConnection::Disconnect, NoneSecurity>();
+		B::BindLuauMethod<"Disconnect", RBXScriptConnection::Disconnect>();
 
 		B::BindToString<&RBXScriptConnection::ToString>();
 	}
@@ -52,11 +51,15 @@ void RBXScriptConnection::Register(lua_State *L) {
 }
 
 bool RBXScriptConnection::IsConnected() const {
-	return emitter->IsConnected(name, id);
+	return emitter->IsConnected(signal, id);
 }
 
-void RBXScriptConnection::Disconnect() {
-	emitter->Disconnect(name, id);
+int RBXScriptConnection::Disconnect(lua_State *L) {
+	RBXScriptConnection *self = LuauStackOp<RBXScriptConnection *>::Check(L, 1);
+	luaSBX_checkserial(L, "call", "RBXScriptConnection.Disconnect");
+
+	self->emitter->Disconnect(self->signal, self->id);
+	return 0;
 }
 
 const char *RBXScriptConnection::ToString() const {
@@ -34,8 +34,8 @@ namespace SBX::DataTypes {
 RBXScriptSignal::RBXScriptSignal() {
 }
 
-RBXScriptSignal::RBXScriptSignal(std::shared_ptr<SignalEmitter> emitter, std::string name, SbxCapability security) :
-		emitter(std::move(emitter)), name(std::move(name)), security(security) {
+RBXScriptSignal::RBXScriptSignal(std::shared_ptr<SignalEmitter> emitter, int signal, SbxCapability security) :
+		emitter(std::move(emitter)), signal(signal), security(security) {
 }
 
 void RBXScriptSignal::Register(lua_State *L) {
@@ -47,6 +47,7 @@ void RBXScriptSignal::Register(lua_State *L) {
 		B::BindLuauMethod<"Connect", RBXScriptSignal::Connect>();
 		B::BindLuauMethod<"Once", RBXScriptSignal::Once>();
 		B::BindLuauMethod<"Wait", RBXScriptSignal::Wait>();
+		B::BindLuauMethod<"ConnectParallel", RBXScriptSignal::ConnectParallel>();
 
 		B::BindToString<&RBXScriptSignal::ToString>();
 		B::BindBinaryOp<TM_EQ, &RBXScriptSignal::operator== >(LuauStackOp<RBXScriptSignal>::Is, LuauStackOp<RBXScriptSignal>::Is);
@@ -55,43 +56,45 @@ void RBXScriptSignal::Register(lua_State *L) {
 	B::InitMetatable(L);
 }
 
-int RBXScriptSignal::Connect(lua_State *L) {
+int RBXScriptSignal::Connect(lua_State *L, bool once, bool parallel) {
 	RBXScriptSignal *self = LuauStackOp<RBXScriptSignal *>::Check(L, 1);
 	if (!lua_isfunction(L, 2)) {
 		luaL_error(L, "Attempt to connect failed: Passed value is not a function");
 	}
 
-	luaSBX_checkcapability(L, self->security, "connect", self->name.c_str());
+	luaSBX_checkcapability(L, self->security, "connect", SignalEmitter::GetSignalName(self->signal).c_str());
+	luaSBX_checkserial(L, "call", "RBXScriptSignal.Connect");
 
-	uint64_t id = self->emitter->Connect(self->name, L, false);
-	LuauStackOp<RBXScriptConnection>::Push(L, RBXScriptConnection(self->emitter, self->name, id));
+	uint64_t id = self->emitter->Connect(self->signal, L, once, parallel);
+	LuauStackOp<RBXScriptConnection>::Push(L, RBXScriptConnection(self->emitter, self->signal, id));
 	return 1;
 }
 
-int RBXScriptSignal::Once(lua_State *L) {
-	RBXScriptSignal *self = LuauStackOp<RBXScriptSignal *>::Check(L, 1);
-	if (!lua_isfunction(L, 2)) {
-		luaL_error(L, "Attempt to connect failed: Passed value is not a function");
-	}
-
-	luaSBX_checkcapability(L, self->security, "connect", self->name.c_str());
+int RBXScriptSignal::Connect(lua_State *L) {
+	return Connect(L, false, false);
+}
 
-	uint64_t id = self->emitter->Connect(self->name, L, true);
-	LuauStackOp<RBXScriptConnection>::Push(L, RBXScriptConnection(self->emitter, self->name, id));
-	return 1;
+int RBXScriptSignal::Once(lua_State *L) {
+	return Connect(L, true, false);
 }
 
 int RBXScriptSignal::Wait(lua_State *L) {
 	RBXScriptSignal *self = LuauStackOp<RBXScriptSignal *>::Check(L, 1);
-	return self->emitter->Wait(self->name, L);
+	luaSBX_checkserial(L, "call", "RBXScriptSignal.Wait");
+
+	return self->emitter->Wait(self->signal, L);
+}
+
+int RBXScriptSignal::ConnectParallel(lua_State *L) {
+	return Connect(L, false, true);
 }
 
 std::string RBXScriptSignal::ToString() const {
-	return "Signal " + name;
+	return "Signal " + SignalEmitter::GetSignalName(signal);
 }
 
 bool RBXScriptSignal::operator==(const RBXScriptSignal &other) const {
-	return emitter == other.emitter && name == other.name;
+	return emitter == other.emitter && signal == other.signal;
 }
 
 } //namespace SBX::DataTypes
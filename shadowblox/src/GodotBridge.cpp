@@ -83,7 +83,7 @@ const char *Part_GetName(Classes::Part *part) {
 }
 
 void Part_SetName(Classes::Part *part, const char *name) {
-	if (part) part->SetName(name);
+	if (part) part->SetName(name ? name : "");
 }
 
 void Part_GetSize(Classes::Part *part, double *x, double *y, double *z) {
@@ -165,7 +165,7 @@ const char *Model_GetName(Classes::Model *model) {
 }
 
 void Model_SetName(Classes::Model *model, const char *name) {
-	if (model) model->SetName(name);
+	if (model) model->SetName(name ? name : "");
 }
 
 std::shared_ptr<Classes::Part> Model_GetPrimaryPart(Classes::Model *model) {
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/MatchHost.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "lua.h"
+
+#include "Sbx/Classes/DataModel.hpp"
+#include "Sbx/Classes/RunService.hpp"
+#include "Sbx/GodotBridge.hpp"
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/Logger.hpp"
+#include "Sbx/Runtime/LuauRuntime.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
+#include "Sbx/Runtime/ThreadPool.hpp"
+#include "Sbx/Runtime/Watchdog.hpp"
+#include "Sbx/RuntimePool.hpp"
+
+namespace SBX {
+
+// Ticks a match may run in one Step to catch up
+#define MATCH_MAX_CATCHUP_TICKS 4
+
+static void luaSBX_matchinit(lua_State *L) {
+	Bridge::RegisterAllClasses(L);
+}
+
+MatchHost::MatchHost(int numWorkers, size_t poolSize, bool freezeSharedState) {
+	Bridge::InitializeAllClasses();
+
+	// Timeout checks only read the watchdog's tick
+	watchdog = std::make_unique<Watchdog>();
+	threadPool = std::make_unique<ThreadPool>(numWorkers);
+
+	// Creates the first runtime on this thread, which initializes the class
+	// metatables and their atoms. They are frozen before the pool's thread
+	// starts creating runtimes.
+	runtimePool = std::make_unique<RuntimePool>(std::max<size_t>(poolSize, 1), luaSBX_matchinit, true, true, freezeSharedState);
+}
+
+MatchHost::~MatchHost() {
+	active.clear();
+
+	// Closed directly, rather than in the background, as the host is going
+	// away with the pool
+	matches.clear();
+
+	// The pool's thread may still be creating runtimes until it is gone. Shared
+	// state is unfrozen with it.
+	runtimePool.reset();
+}
+
+MatchId MatchHost::CreateMatch(double tickRate) {
+	std::unique_ptr<Match> match = std::make_unique<Match>();
+	match->pooled = runtimePool->Acquire();
+	match->logger = std::make_unique<Logger>();
+	match->scheduler = std::make_unique<TaskScheduler>(match->pooled->runtime.get());
+	match->tickInterval = tickRate > 0.0 ? 1.0 / tickRate : 0.0;
+
+	for (int i = 0; i < VMMax; i++) {
+		SbxGlobalThreadData *global = luaSBX_getthreaddata(match->pooled->runtime->GetVM(VMType(i)))->global;
+		global->logger = match->logger.get();
+		global->scheduler = match->scheduler.get();
+	}
+
+	std::shared_ptr<Classes::RunService> runService = match->pooled->dataModel->GetRunService();
+	runService->SetScheduler(match->scheduler.get());
+	runService->Run();
+
+	MatchId id = nextId++;
+	active.push_back(match.get());
+	matches.emplace(id, std::move(match));
+
+	return id;
+}
+
+void MatchHost::DestroyMatch(MatchId id) {
+	auto it = matches.find(id);
+	if (it == matches.end()) {
+		return;
+	}
+
+	Match *match = it->second.get();
+	active.erase(std::find(active.begin(), active.end(), match));
+
+	// Cancels the match's tasks and detaches its scheduler and logger, so they
+	// can go now while the VMs are closed in the background
+	runtimePool->Release(std::move(match->pooled));
+	matches.erase(it);
+}
+
+bool MatchHost::HasMatch(MatchId id) const {
+	return matches.find(id) != matches.end();
+}
+
+MatchHost::Match *MatchHost::GetMatch(MatchId id) const {
+	auto it = matches.find(id);
+	return it != matches.end() ? it->second.get() : nullptr;
+}
+
+LuauRuntime *MatchHost::GetRuntime(MatchId id) const {
+	Match *match = GetMatch(id);
+	return match ? match->pooled->runtime.get() : nullptr;
+}
+
+std::shared_ptr<Classes::DataModel> MatchHost::GetDataModel(MatchId id) const {
+	Match *match = GetMatch(id);
+	return match ? match->pooled->dataModel : nullptr;
+}
+
+TaskScheduler *MatchHost::GetScheduler(MatchId id) const {
+	Match *match = GetMatch(id);
+	return match ? match->scheduler.get() : nullptr;
+}
+
+Logger *MatchHost::GetLogger(MatchId id) const {
+	Match *match = GetMatch(id);
+	return match ? match->logger.get() : nullptr;
+}
+
+void MatchHost::SetNetworkCallbacks(MatchId id, NetworkEventCallback event, NetworkFunctionCallback function) {
+	Match *match = GetMatch(id);
+	if (!match) {
+		return;
+	}
+
+	LuauRuntime *runtime = match->pooled->runtime.get();
+	auto setCallbacks = [&](lua_State *L) {
+		SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+		global->networkEventCallback = event;
+		global->networkFunctionCallback = function;
+	};
+
+	for (int i = 0; i < VMMax; i++) {
+		setCallbacks(runtime->GetVM(VMType(i)));
+	}
+
+	for (size_t i = 0; i < runtime->NumActors(); i++) {
+		setCallbacks(runtime->GetActor(i));
+	}
+}
+
+double MatchHost::GetStepTime(MatchId id) const {
+	Match *match = GetMatch(id);
+	return match ? match->stepTime : 0.0;
+}
+
+void MatchHost::StepMatch(Match &match, double delta) {
+	double start = lua_clock();
+	std::shared_ptr<Classes::RunService> runService = match.pooled->dataModel->GetRunService();
+
+	if (match.tickInterval <= 0.0) {
+		runService->StepFrame(delta);
+		match.scheduler->GCStep(delta);
+	} else {
+		match.pending += delta;
+
+		int ticks = 0;
+		while (match.pending >= match.tickInterval && ticks < MATCH_MAX_CATCHUP_TICKS) {
+			runService->StepFrame(match.tickInterval);
+			match.scheduler->GCStep(match.tickInterval);
+
+			match.pending -= match.tickInterval;
+			ticks++;
+		}
+
+		match.pending = std::min(match.pending, match.tickInterval);
+	}
+
+	match.stepTime = lua_clock() - start;
+}
+
+void MatchHost::Step(double delta) {
+	threadPool->Run(active.size(), [this, delta](size_t i) {
+		StepMatch(*active[i], delta);
+	});
+}
+
+} //namespace SBX
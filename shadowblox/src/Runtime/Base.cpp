@@ -14,8 +14,13 @@
 
 #include "Sbx/Runtime/Base.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <utility>
 
 #include "Luau/CodeGen.h"
 #include "lua.h"
@@ -23,8 +28,11 @@
 
 #include "Sbx/Runtime/Logger.hpp"
 #include "Sbx/Runtime/SignalEmitter.hpp"
+#include "Sbx/Runtime/SlabAllocator.hpp"
 #include "Sbx/Runtime/Stack.hpp"
+#include "Sbx/Runtime/StringMap.hpp"
 #include "Sbx/Runtime/TaskScheduler.hpp"
+#include "Sbx/Runtime/Watchdog.hpp"
 
 namespace SBX {
 
@@ -49,7 +57,15 @@ static SbxThreadData *luaSBX_initthreaddata(lua_State *LP, lua_State *L) {
 		udata->additionalCapability = parentUdata->additionalCapability;
 		udata->objRegistry = parentUdata->objRegistry;
 		udata->weakObjRegistry = parentUdata->weakObjRegistry;
+		udata->classMetatables = parentUdata->classMetatables;
+		udata->signalCache = parentUdata->signalCache;
+		udata->threadRegistry = parentUdata->threadRegistry;
 		udata->signalConnections = parentUdata->signalConnections;
+		udata->desynchronized = parentUdata->desynchronized;
+		udata->cpuUsage = parentUdata->cpuUsage;
+		if (udata->cpuUsage) {
+			udata->cpuUsage->numThreads++;
+		}
 		udata->global = parentUdata->global;
 		udata->userdata = parentUdata->userdata;
 	}
@@ -71,13 +87,30 @@ static void luaSBX_userthread(lua_State *LP, lua_State *L) {
 			udata->signalConnections->Clear();
 		}
 
+		luaSBX_setcpuusage(L, nullptr);
+
 		lua_setthreaddata(L, nullptr);
 		delete udata;
 	}
 }
 
-lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity) {
-	lua_State *L = lua_newstate(luaSBX_alloc, nullptr);
+static StringMap<int16_t> &luaSBX_atoms() {
+	static StringMap<int16_t> atoms;
+	return atoms;
+}
+
+static std::atomic<int> atomsFrozen = 0;
+
+static int16_t luaSBX_useratom(lua_State * /*L*/, const char *s, size_t l) {
+	return luaSBX_findatom(s, l);
+}
+
+lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity, bool slabAllocator) {
+	SlabAllocator *allocator = slabAllocator ? new SlabAllocator : nullptr;
+	lua_State *L = allocator ? lua_newstate(SlabAllocator::Alloc, allocator) : lua_newstate(luaSBX_alloc, nullptr);
+
+	// Must be set before any strings are interned
+	lua_callbacks(L)->useratom = luaSBX_useratom;
 
 	if (Luau::CodeGen::isSupported()) {
 		Luau::CodeGen::create(L);
@@ -93,6 +126,8 @@ lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity) {
 	udata->vmType = vmType;
 	udata->identity = defaultIdentity;
 	udata->global = new SbxGlobalThreadData;
+	udata->global->allocator = allocator;
+	udata->global->connections = new SignalConnectionOwner;
 
 	// Overridden in LuauRuntime to be synced with other VMs
 	udata->global->initTimestamp = lua_clock();
@@ -117,6 +152,28 @@ lua_State *luaSBX_newstate(VMType vmType, SbxIdentity defaultIdentity) {
 	udata->weakObjRegistry = lua_ref(L, -1);
 	lua_pop(L, 1);
 
+	lua_newtable(L);
+
+	// Signal objects, by object userdata (weak key)
+	lua_newtable(L);
+	lua_pushstring(L, "k");
+	lua_setfield(L, -2, "__mode");
+	lua_setreadonly(L, -1, true);
+	lua_setmetatable(L, -2);
+
+	udata->signalCache = lua_ref(L, -1);
+	lua_pop(L, 1);
+
+	// Scheduled threads, by slot
+	lua_newtable(L);
+	udata->threadRegistry = lua_ref(L, -1);
+	lua_pop(L, 1);
+
+	// Class metatables, by index
+	lua_newtable(L);
+	udata->classMetatables = lua_ref(L, -1);
+	lua_pop(L, 1);
+
 	return L;
 }
 
@@ -127,6 +184,37 @@ lua_State *luaSBX_newthread(lua_State *L, SbxIdentity identity) {
 	return T;
 }
 
+int luaSBX_refthread(lua_State *T) {
+	SbxThreadData *udata = luaSBX_getthreaddata(T);
+	SbxGlobalThreadData *global = udata->global;
+
+	int slot;
+	if (global->freeThreadSlots.empty()) {
+		slot = ++global->threadSlotCount;
+	} else {
+		slot = global->freeThreadSlots.back();
+		global->freeThreadSlots.pop_back();
+	}
+
+	lua_getref(T, udata->threadRegistry);
+	lua_pushthread(T);
+	lua_rawseti(T, -2, slot);
+	lua_pop(T, 1); // table
+
+	return slot;
+}
+
+void luaSBX_unrefthread(lua_State *T, int slot) {
+	SbxThreadData *udata = luaSBX_getthreaddata(T);
+
+	lua_getref(T, udata->threadRegistry);
+	lua_pushnil(T);
+	lua_rawseti(T, -2, slot);
+	lua_pop(T, 1); // table
+
+	udata->global->freeThreadSlots.push_back(slot);
+}
+
 SbxThreadData *luaSBX_getthreaddata(lua_State *L) {
 	return reinterpret_cast<SbxThreadData *>(lua_getthreaddata(L));
 }
@@ -136,16 +224,24 @@ void luaSBX_close(lua_State *L) {
 
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 
+	// Tasks of other threads keep their thread alive, so they must be released
+	// while the VM is still usable
 	if (udata->global->scheduler) {
-		udata->global->scheduler->CancelThread(L);
+		udata->global->scheduler->CancelVM(L);
 	}
 
 	if (udata->signalConnections) {
 		udata->signalConnections->Clear();
 	}
 
+	udata->global->connections->Clear();
+
+	// References are released with the registry
+	udata->global->closing = true;
 	lua_close(L);
 
+	delete udata->global->connections;
+	delete udata->global->allocator;
 	delete udata->global;
 	delete udata;
 }
@@ -232,6 +328,44 @@ void luaSBX_checkcapability(lua_State *L, SbxCapability capability, const char *
 	}
 }
 
+void luaSBX_checkserial(lua_State *L, const char *action, const char *target) {
+	if (luaSBX_getthreaddata(L)->desynchronized) {
+		luaSBX_parallelerror(L, action, target);
+	}
+}
+
+int16_t luaSBX_addatom(const char *str) {
+	StringMap<int16_t> &atoms = luaSBX_atoms();
+
+	auto it = atoms.find(str);
+	if (it != atoms.end()) {
+		return it->second;
+	}
+
+	if (atomsFrozen > 0 || atoms.size() >= INT16_MAX) {
+		return -1;
+	}
+
+	int16_t atom = static_cast<int16_t>(atoms.size());
+	atoms[str] = atom;
+	return atom;
+}
+
+void luaSBX_freezeatoms() {
+	atomsFrozen++;
+}
+
+void luaSBX_unfreezeatoms() {
+	atomsFrozen--;
+}
+
+int16_t luaSBX_findatom(const char *str, size_t len) {
+	const StringMap<int16_t> &atoms = luaSBX_atoms();
+
+	auto it = atoms.find(std::string_view(str, len));
+	return it != atoms.end() ? it->second : -1;
+}
+
 bool luaSBX_pushregistry(lua_State *L, void *ptr, void *userdata, void (*push)(lua_State *L, void *ptr, void *userdata), bool weak) {
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 	lua_getref(L, weak ? udata->weakObjRegistry : udata->objRegistry);
@@ -253,6 +387,23 @@ bool luaSBX_pushregistry(lua_State *L, void *ptr, void *userdata, void (*push)(l
 	return res;
 }
 
+bool luaSBX_pushclassmetatable(lua_State *L, int index) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	lua_getref(L, udata->classMetatables);
+	lua_rawgeti(L, -1, index + 1);
+	lua_remove(L, -2); // table
+
+	return !lua_isnil(L, -1);
+}
+
+void luaSBX_setclassmetatable(lua_State *L, int index) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	lua_getref(L, udata->classMetatables);
+	lua_pushvalue(L, -2);
+	lua_rawseti(L, -2, index + 1);
+	lua_pop(L, 1); // table
+}
+
 void luaSBX_debugcallbacks(lua_State *L) {
 	lua_Callbacks *cb = lua_callbacks(L);
 	cb->interrupt = luaSBX_cbinterrupt;
@@ -265,46 +416,164 @@ void luaSBX_cbinterrupt(lua_State *L, int gc) {
 		return;
 	}
 
-	if (gc < 0 && (uint64_t)(lua_clock() * 1e6) > udata->interruptDeadline) {
+	if (gc < 0 && Watchdog::Now() > udata->interruptDeadline) {
 		lua_checkstack(L, 1);
 		luaL_error(L, "Script timed out: exhausted allowed execution time");
 	}
 }
 
-int luaSBX_resume(lua_State *L, lua_State *from, int nargs, double timeout) {
-	// TODO: Possible to avoid setting timeouts?
-	// Maybe use preprocessor defines
-	luaSBX_getthreaddata(L)->interruptDeadline = (uint64_t)((lua_clock() + timeout) * 1e6);
+static bool luaSBX_compilenative(lua_State *L, int index, unsigned int flags) {
+	Luau::CodeGen::CompilationStats stats;
+	Luau::CodeGen::CompilationResult result = Luau::CodeGen::compile(L, index, flags, &stats);
 
-	int status = lua_resume(L, from, nargs);
+	SbxNativeStats &nativeStats = luaSBX_getthreaddata(L)->global->nativeStats;
+	nativeStats.functionsCompiled += stats.functionsCompiled;
+	nativeStats.bytesCompiled += stats.nativeCodeSizeBytes;
 
-	// TODO: Debug break if applicable
-	if (status != LUA_OK && status != LUA_YIELD) {
-		SbxThreadData *udata = luaSBX_getthreaddata(L);
-		if (udata->global->logger) {
-			udata->global->logger->Error(lua_tostring(L, -1));
+	return result.result == Luau::CodeGen::CodeGenCompilationResult::Success && stats.functionsCompiled > 0;
+}
+
+bool luaSBX_loadnative(lua_State *L, int index, SbxCpuUsage *usage) {
+	SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+	if (!Luau::CodeGen::isSupported() || global->nativeMode == NativeCodeMode::Disabled) {
+		return false;
+	}
+
+	if (global->nativeMode == NativeCodeMode::All) {
+		return luaSBX_compilenative(L, index, Luau::CodeGen::CodeGen_ColdFunctions);
+	}
+
+	if (luaSBX_compilenative(L, index, Luau::CodeGen::CodeGen_OnlyNativeModules)) {
+		return true;
+	}
+
+	if (usage && global->nativeHotThreshold > 0.0 && usage->nativeRef == LUA_NOREF) {
+		lua_pushvalue(L, index);
+		usage->nativeRef = lua_ref(L, -1);
+		lua_pop(L, 1);
+	}
+
+	return false;
+}
+
+// Frames already running stay interpreted; later calls run natively
+static void luaSBX_promotenative(lua_State *L, SbxCpuUsage *usage) {
+	if (!lua_checkstack(L, 1)) {
+		return;
+	}
+
+	lua_getref(L, usage->nativeRef);
+	if (luaSBX_compilenative(L, -1, 0)) {
+		luaSBX_getthreaddata(L)->global->nativeStats.hotScripts++;
+	}
+
+	lua_pop(L, 1);
+
+	lua_unref(L, usage->nativeRef);
+	usage->nativeRef = LUA_NOREF;
+}
+
+// Time spent in resumptions nested in the current one, so that it is charged
+// only to the innermost thread. Resumptions nest on one OS thread, which in
+// the parallel phase runs one VM at a time.
+static thread_local double nestedCpuTime = 0.0;
+
+void luaSBX_setcpuusage(lua_State *T, std::shared_ptr<SbxCpuUsage> usage) {
+	SbxThreadData *udata = luaSBX_getthreaddata(T);
+	if (udata->cpuUsage == usage) {
+		return;
+	}
+
+	if (usage) {
+		usage->numThreads++;
+	}
+
+	std::shared_ptr<SbxCpuUsage> previous = std::move(udata->cpuUsage);
+	udata->cpuUsage = std::move(usage);
+
+	// The script has stopped, so its function need not be kept for later
+	// compilation
+	if (previous && --previous->numThreads == 0 && previous->nativeRef != LUA_NOREF) {
+		if (!udata->global->closing) {
+			lua_unref(T, previous->nativeRef);
 		}
+
+		previous->nativeRef = LUA_NOREF;
 	}
+}
 
-	return status;
+// Where a watchdog runs, its tick is read instead of the system clock. It is
+// coarse, but resumptions start at arbitrary points between ticks, so the time
+// charged is right on average.
+static double luaSBX_accountingclock() {
+	if (Watchdog::IsRunning()) {
+		return Watchdog::Now() * 1e-3;
+	}
+
+	return lua_clock();
 }
 
-int luaSBX_pcall(lua_State *L, int nargs, int nresults, int errfunc, double timeout) {
-	// TODO: Possible to avoid setting timeouts?
-	// Maybe use preprocessor defines
-	luaSBX_getthreaddata(L)->interruptDeadline = (uint64_t)((lua_clock() + timeout) * 1e6);
+template <typename F>
+static int luaSBX_runaccounted(lua_State *L, F run) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	SbxGlobalThreadData *global = udata->global;
+
+	double outerNested = nestedCpuTime;
+	nestedCpuTime = 0.0;
+
+	double start = luaSBX_accountingclock();
+	int status = run();
+	double elapsed = luaSBX_accountingclock() - start;
+
+	// Negative only if a watchdog started or stopped in between
+	double self = std::max(elapsed - nestedCpuTime, 0.0);
+	nestedCpuTime = outerNested + elapsed;
+
+	udata->cpuTime += self;
+	if (udata->cpuUsage) {
+		SbxCpuUsage *usage = udata->cpuUsage.get();
+		usage->time.fetch_add(self, std::memory_order_relaxed);
+		usage->resumptions.fetch_add(1, std::memory_order_relaxed);
 
-	int status = lua_pcall(L, nargs, nresults, errfunc);
+		// Code generation is not thread safe
+		if (!global->parallelPhase && usage->nativeRef != LUA_NOREF && usage->time >= global->nativeHotThreshold) {
+			luaSBX_promotenative(L, usage);
+		}
+	}
 
 	// TODO: Debug break if applicable
 	if (status != LUA_OK && status != LUA_YIELD) {
-		SbxThreadData *udata = luaSBX_getthreaddata(L);
-		if (udata->global->logger) {
-			udata->global->logger->Error(lua_tostring(L, -1));
+		if (global->logger) {
+			global->logger->Error(lua_tostring(L, -1));
 		}
 	}
 
 	return status;
 }
 
+// Without a timeout, interrupts return before reading the clock
+static uint64_t luaSBX_deadline(double timeout) {
+	if (timeout <= 0.0) {
+		return 0;
+	}
+
+	return Watchdog::Now() + (uint64_t)(timeout * 1e3);
+}
+
+int luaSBX_resume(lua_State *L, lua_State *from, int nargs, double timeout) {
+	luaSBX_getthreaddata(L)->interruptDeadline = luaSBX_deadline(timeout);
+
+	return luaSBX_runaccounted(L, [=]() {
+		return lua_resume(L, from, nargs);
+	});
+}
+
+int luaSBX_pcall(lua_State *L, int nargs, int nresults, int errfunc, double timeout) {
+	luaSBX_getthreaddata(L)->interruptDeadline = luaSBX_deadline(timeout);
+
+	return luaSBX_runaccounted(L, [=]() {
+		return lua_pcall(L, nargs, nresults, errfunc);
+	});
+}
+
 } //namespace SBX
@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/Runtime/BytecodeCache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "Luau/Bytecode.h"
+#include "Luau/Compiler.h"
+
+namespace SBX {
+
+#define BYTECODE_FILE_EXT ".luauc"
+
+// Header: magic, then little endian 64-bit length and checksum of the bytecode
+#define BYTECODE_FILE_MAGIC "SBXC"
+#define BYTECODE_FILE_MAGIC_SIZE 4
+#define BYTECODE_FILE_HEADER_SIZE (BYTECODE_FILE_MAGIC_SIZE + 16)
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+// Seeds the second half of the key, so it is independent of the first
+#define FNV_SECOND_SEED 0x9e3779b97f4a7c15ull
+
+static void luaSBX_keystring(std::string &key, const char *str) {
+	// Distinguish null from empty
+	if (str) {
+		key += str;
+		key += '\1';
+	} else {
+		key += '\2';
+	}
+}
+
+static void luaSBX_keylist(std::string &key, const char *const *list) {
+	if (list) {
+		for (const char *const *it = list; *it; it++) {
+			luaSBX_keystring(key, *it);
+		}
+	}
+
+	key += '\3';
+}
+
+static uint64_t luaSBX_fnv1a(std::string_view data, uint64_t seed) {
+	uint64_t hash = FNV_OFFSET_BASIS ^ seed;
+	for (char c : data) {
+		hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+	}
+
+	// Final avalanche, so that similar inputs differ in every digit
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+static void luaSBX_writeu64(char *out, uint64_t value) {
+	for (int i = 0; i < 8; i++) {
+		out[i] = static_cast<char>((value >> (i * 8)) & 0xff);
+	}
+}
+
+static uint64_t luaSBX_readu64(const char *in) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (i * 8);
+	}
+
+	return value;
+}
+
+// Unique among writers in this process and (most likely) in others sharing
+// the directory
+static std::string luaSBX_tmpsuffix() {
+	static const uint64_t processToken = (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()();
+	static std::atomic<uint64_t> counter = 0;
+
+	char suffix[48];
+	snprintf(suffix, sizeof(suffix), ".%016llx.%llu.tmp", (unsigned long long)processToken, (unsigned long long)counter++);
+	return suffix;
+}
+
+BytecodeCache::BytecodeCache(std::string directory, size_t maxEntries) :
+		directory(std::move(directory)),
+		maxEntries(maxEntries > 0 ? maxEntries : 1) {
+	if (!this->directory.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(this->directory, ec);
+	}
+}
+
+std::string BytecodeCache::HashKey(std::string_view source, const Luau::CompileOptions &opts, std::string_view optionsKey) {
+	std::string material(source);
+	material += '\0';
+
+	// Bytecode from another Luau version may not load (or worse, load wrong)
+	material += std::to_string(LBC_VERSION_TARGET) + ',';
+
+	material += std::to_string(opts.optimizationLevel) + ',';
+	material += std::to_string(opts.debugLevel) + ',';
+	material += std::to_string(opts.typeInfoLevel) + ',';
+	material += std::to_string(opts.coverageLevel) + ',';
+	luaSBX_keystring(material, opts.vectorLib);
+	luaSBX_keystring(material, opts.vectorCtor);
+	luaSBX_keystring(material, opts.vectorType);
+	luaSBX_keylist(material, opts.mutableGlobals);
+	luaSBX_keylist(material, opts.userdataTypes);
+	luaSBX_keylist(material, opts.librariesWithKnownMembers);
+	luaSBX_keylist(material, opts.disabledBuiltins);
+	material += optionsKey;
+
+	// Persisted keys must be stable across runs and platforms, so std::hash
+	// cannot be used
+	uint64_t high = luaSBX_fnv1a(material, 0);
+	uint64_t low = luaSBX_fnv1a(material, FNV_SECOND_SEED);
+
+	char key[33];
+	snprintf(key, sizeof(key), "%016llx%016llx", (unsigned long long)high, (unsigned long long)low);
+	return key;
+}
+
+std::string BytecodeCache::Compile(std::string_view source, const Luau::CompileOptions &opts, std::string_view optionsKey) {
+	std::string key = HashKey(source, opts, optionsKey);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			stats.hits++;
+			lru.splice(lru.begin(), lru, it->second.lruIt);
+			return it->second.bytecode;
+		}
+	}
+
+	// Compile outside the lock, so other scripts are not held up. A script
+	// compiled concurrently by two callers is simply stored twice.
+	std::string bytecode;
+	bool fromDisk = LoadFile(key, bytecode);
+
+	if (!fromDisk) {
+		bytecode = Luau::compile(std::string(source), opts);
+		SaveFile(key, bytecode);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (fromDisk) {
+		stats.hits++;
+		stats.diskHits++;
+	} else {
+		stats.misses++;
+	}
+
+	Insert(std::move(key), bytecode);
+	return bytecode;
+}
+
+void BytecodeCache::Insert(std::string key, const std::string &bytecode) {
+	auto it = entries.find(key);
+	if (it != entries.end()) {
+		it->second.bytecode = bytecode;
+		lru.splice(lru.begin(), lru, it->second.lruIt);
+		return;
+	}
+
+	while (entries.size() >= maxEntries) {
+		entries.erase(lru.back());
+		lru.pop_back();
+		stats.evictions++;
+	}
+
+	lru.push_front(key);
+	entries.emplace(std::move(key), Entry{ bytecode, lru.begin() });
+}
+
+bool BytecodeCache::LoadFile(const std::string &key, std::string &outBytecode) const {
+	if (directory.empty()) {
+		return false;
+	}
+
+	std::ifstream file(std::filesystem::path(directory) / (key + BYTECODE_FILE_EXT), std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	std::string contents(std::istreambuf_iterator<char>(file), {});
+	if (file.bad() || contents.size() < BYTECODE_FILE_HEADER_SIZE ||
+			memcmp(contents.data(), BYTECODE_FILE_MAGIC, BYTECODE_FILE_MAGIC_SIZE) != 0) {
+		return false;
+	}
+
+	// Truncated or corrupt files are treated as a miss, and overwritten
+	std::string_view bytecode = std::string_view(contents).substr(BYTECODE_FILE_HEADER_SIZE);
+	uint64_t length = luaSBX_readu64(contents.data() + BYTECODE_FILE_MAGIC_SIZE);
+	uint64_t checksum = luaSBX_readu64(contents.data() + BYTECODE_FILE_MAGIC_SIZE + 8);
+
+	if (bytecode.empty() || length != bytecode.size() || checksum != luaSBX_fnv1a(bytecode, 0)) {
+		return false;
+	}
+
+	outBytecode.assign(bytecode);
+	return true;
+}
+
+void BytecodeCache::SaveFile(const std::string &key, const std::string &bytecode) const {
+	if (directory.empty()) {
+		return;
+	}
+
+	// Written to a temporary file first so that readers never see a partial
+	// file. Each writer has its own, since the same script may be saved by
+	// several runtimes (or processes) at once.
+	std::filesystem::path path = std::filesystem::path(directory) / (key + BYTECODE_FILE_EXT);
+	std::filesystem::path tmpPath = path;
+	tmpPath += luaSBX_tmpsuffix();
+
+	char header[BYTECODE_FILE_HEADER_SIZE];
+	memcpy(header, BYTECODE_FILE_MAGIC, BYTECODE_FILE_MAGIC_SIZE);
+	luaSBX_writeu64(header + BYTECODE_FILE_MAGIC_SIZE, bytecode.size());
+	luaSBX_writeu64(header + BYTECODE_FILE_MAGIC_SIZE + 8, luaSBX_fnv1a(bytecode, 0));
+
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return;
+		}
+
+		file.write(header, sizeof(header));
+		file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+		if (!file) {
+			file.close();
+
+			std::error_code ec;
+			std::filesystem::remove(tmpPath, ec);
+			return;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec) {
+		std::filesystem::remove(tmpPath, ec);
+	}
+}
+
+void BytecodeCache::Clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	lru.clear();
+}
+
+BytecodeCacheStats BytecodeCache::GetStats() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+size_t BytecodeCache::Size() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+} //namespace SBX
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/Runtime/CompileOptions.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#include "Luau/Compiler.h"
+
+namespace SBX {
+
+// Globals rebound by the host after scripts load, which must not be resolved
+// as imports at load time
+static const char *MUTABLE_GLOBALS[] = {
+	"game",
+	"Game",
+	"workspace",
+	"Workspace",
+	"script",
+	"shared",
+	nullptr
+};
+
+static const char *KNOWN_LIBRARIES[] = {
+	"math",
+	nullptr
+};
+
+static void luaSBX_libraryconstant(const char *library, const char *member, Luau::CompileConstant *constant) {
+	if (strcmp(library, "math") == 0) {
+		if (strcmp(member, "pi") == 0) {
+			Luau::setCompileConstantNumber(constant, std::numbers::pi);
+		} else if (strcmp(member, "huge") == 0) {
+			Luau::setCompileConstantNumber(constant, HUGE_VAL);
+		}
+	}
+}
+
+static Luau::CompileOptions luaSBX_makecompileoptions(CompileProfile profile) {
+	Luau::CompileOptions opts;
+	opts.mutableGlobals = MUTABLE_GLOBALS;
+
+	if (profile == CompileProfile::Debug) {
+		opts.optimizationLevel = 0;
+		opts.debugLevel = 2;
+		return opts;
+	}
+
+	opts.optimizationLevel = 2;
+	opts.debugLevel = 1; // line info for errors
+	opts.librariesWithKnownMembers = KNOWN_LIBRARIES;
+	opts.libraryMemberConstantCb = luaSBX_libraryconstant;
+
+	return opts;
+}
+
+const Luau::CompileOptions &luaSBX_compileoptions(CompileProfile profile) {
+	static const Luau::CompileOptions debug = luaSBX_makecompileoptions(CompileProfile::Debug);
+	static const Luau::CompileOptions release = luaSBX_makecompileoptions(CompileProfile::Release);
+
+	return profile == CompileProfile::Debug ? debug : release;
+}
+
+const char *luaSBX_compileprofilename(CompileProfile profile) {
+	return profile == CompileProfile::Debug ? "debug" : "release";
+}
+
+} //namespace SBX
@@ -14,19 +14,21 @@
 
 #include "Sbx/Runtime/LuauRuntime.hpp"
 
+#include <cstddef>
 #include <cstdint>
 
 #include "lua.h"
 #include "lualib.h"
 
 #include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/SlabAllocator.hpp"
 
 namespace SBX {
 
-LuauRuntime::LuauRuntime(void (*initCallback)(lua_State *), bool debug) :
-		initCallback(initCallback) {
-	vms[CoreVM] = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
-	vms[UserVM] = luaSBX_newstate(UserVM, GameScriptIdentity);
+LuauRuntime::LuauRuntime(void (*initCallback)(lua_State *), bool debug, bool slabAllocator) :
+		initCallback(initCallback), debug(debug), slabAllocator(slabAllocator) {
+	vms[CoreVM] = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity, slabAllocator);
+	vms[UserVM] = luaSBX_newstate(UserVM, GameScriptIdentity, slabAllocator);
 
 	double init = lua_clock();
 	for (int i = 0; i < VMMax; i++) {
@@ -38,6 +40,12 @@ LuauRuntime::LuauRuntime(void (*initCallback)(lua_State *), bool debug) :
 }
 
 LuauRuntime::~LuauRuntime() {
+	for (lua_State *L : actors) {
+		luaSBX_close(L);
+	}
+
+	actors.clear();
+
 	for (lua_State *&L : vms) {
 		luaSBX_close(L);
 		L = nullptr;
@@ -66,11 +74,52 @@ lua_State *LuauRuntime::GetVM(VMType type) {
 	return vms[type];
 }
 
-void LuauRuntime::GCStep(const uint32_t *step, double delta) {
-	for (int i = 0; i < VMMax; i++) {
-		lua_State *L = GetVM(VMType(i));
-		lua_gc(L, LUA_GCSTEP, step[i] * delta);
+lua_State *LuauRuntime::CreateActor() {
+	lua_State *L = luaSBX_newstate(UserVM, GameScriptIdentity, slabAllocator);
+
+	SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+	const SbxGlobalThreadData *user = luaSBX_getthreaddata(vms[UserVM])->global;
+
+	global->initTimestamp = user->initTimestamp;
+	global->logger = user->logger;
+	global->scheduler = user->scheduler;
+	global->nativeMode = user->nativeMode;
+	global->nativeHotThreshold = user->nativeHotThreshold;
+	global->networkEventCallback = user->networkEventCallback;
+	global->networkFunctionCallback = user->networkFunctionCallback;
+
+	InitVM(L, debug);
+	actors.push_back(L);
+
+	return L;
+}
+
+double LuauRuntime::GCStep(VMType vm, uint32_t stepKB) {
+	return GCStep(GetVM(vm), stepKB);
+}
+
+double LuauRuntime::GCStep(lua_State *L, uint32_t stepKB) {
+	double start = lua_clock();
+	lua_gc(L, LUA_GCSTEP, static_cast<int>(stepKB));
+	return lua_clock() - start;
+}
+
+size_t LuauRuntime::GetPageBytes() const {
+	auto pageBytes = [](lua_State *L) -> size_t {
+		const SlabAllocator *allocator = luaSBX_getthreaddata(L)->global->allocator;
+		return allocator ? allocator->GetStats().pageBytes : 0;
+	};
+
+	size_t total = 0;
+	for (lua_State *L : vms) {
+		total += pageBytes(L);
 	}
+
+	for (lua_State *L : actors) {
+		total += pageBytes(L);
+	}
+
+	return total;
 }
 
 void LuauRuntime::GCSize(int32_t *outBuffer) {
@@ -14,21 +14,27 @@
 
 #include "Sbx/Runtime/SignalEmitter.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "lua.h"
 
 #include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/Logger.hpp"
+#include "Sbx/Runtime/StringMap.hpp"
 #include "Sbx/Runtime/TaskScheduler.hpp"
 
 namespace SBX {
 
 // Static member definition
-bool SignalEmitter::shutdownMode = false;
+thread_local bool SignalEmitter::shutdownMode = false;
 
 void SignalEmitter::SetShutdownMode(bool shutdown) {
 	shutdownMode = shutdown;
@@ -38,6 +44,45 @@ bool SignalEmitter::IsShutdownMode() {
 	return shutdownMode;
 }
 
+// Signal IDs are resolved once per binding and cached, so a lock is cheap
+// enough here
+static std::mutex &luaSBX_signalmutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+static StringMap<int> &luaSBX_signalids() {
+	static StringMap<int> ids;
+	return ids;
+}
+
+// Names must not move, since references to them are handed out
+static std::deque<std::string> &luaSBX_signalnames() {
+	static std::deque<std::string> names;
+	return names;
+}
+
+int SignalEmitter::GetSignalId(std::string_view name) {
+	std::lock_guard<std::mutex> lock(luaSBX_signalmutex());
+	StringMap<int> &ids = luaSBX_signalids();
+
+	auto it = ids.find(name);
+	if (it != ids.end()) {
+		return it->second;
+	}
+
+	std::deque<std::string> &names = luaSBX_signalnames();
+	int id = static_cast<int>(names.size());
+	names.emplace_back(name);
+	ids.emplace(name, id);
+	return id;
+}
+
+const std::string &SignalEmitter::GetSignalName(int id) {
+	std::lock_guard<std::mutex> lock(luaSBX_signalmutex());
+	return luaSBX_signalnames()[id];
+}
+
 void luaSBX_reentrancyerror(lua_State *L, const char *signalName) {
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 	if (!udata->global->logger) {
@@ -60,24 +105,30 @@ SignalEmitter::SignalEmitter() {}
 SignalEmitter::~SignalEmitter() {
 	// During shutdown, Luau runtime is destroyed so skip all Lua operations
 	if (shutdownMode) {
-		connections.clear();
-		pendingTasks.clear();
+		signals.clear();
 		return;
 	}
 
-	for (const auto &[connName, conns] : connections) {
-		for (const auto &[id, conn] : conns) {
+	for (const SignalState &state : signals) {
+		for (const Connection &conn : state.connections) {
+			if (conn.ref == LUA_NOREF) {
+				continue;
+			}
+
 			SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
 			if (udata->signalConnections) {
 				udata->signalConnections->ClearEmitter(this);
 			}
+			udata->global->connections->ClearEmitter(this);
 
 			lua_unref(conn.L, conn.ref);
 		}
 	}
 
-	for (const auto &[name, tasks] : pendingTasks) {
-		for (SignalWaitTask *task : tasks) {
+	for (const SignalState &state : signals) {
+		for (SignalWaitTask *task : state.pendingTasks) {
+			task->emitter = nullptr;
+
 			lua_State *T = task->GetThread();
 			SbxThreadData *udata = luaSBX_getthreaddata(T);
 			if (udata->global->scheduler) {
@@ -91,87 +142,198 @@ void SignalEmitter::SetDeferred(bool isDeferred) {
 	deferred = isDeferred;
 }
 
-uint64_t SignalEmitter::Connect(const std::string &signal, lua_State *L, bool once) {
+SignalEmitter::SignalState &SignalEmitter::GetSignalState(int signal) {
+	auto it = std::lower_bound(signals.begin(), signals.end(), signal, [](const SignalState &state, int value) {
+		return state.signal < value;
+	});
+	if (it == signals.end() || it->signal != signal) {
+		it = signals.insert(it, SignalState{ signal });
+	}
+
+	return *it;
+}
+
+SignalEmitter::SignalState *SignalEmitter::FindSignalState(int signal) {
+	return const_cast<SignalState *>(std::as_const(*this).FindSignalState(signal));
+}
+
+const SignalEmitter::SignalState *SignalEmitter::FindSignalState(int signal) const {
+	auto it = std::lower_bound(signals.begin(), signals.end(), signal, [](const SignalState &state, int value) {
+		return state.signal < value;
+	});
+	return it != signals.end() && it->signal == signal ? &*it : nullptr;
+}
+
+bool SignalEmitter::HasListeners(int signal) const {
+	if (numListeners == 0) {
+		return false;
+	}
+
+	const SignalState *state = FindSignalState(signal);
+	return state && state->numListeners > 0;
+}
+
+uint64_t SignalEmitter::Connect(int signal, lua_State *L, bool once, bool parallel) {
 	uint64_t id = nextId++;
-	connections[signal][id] = { L, lua_ref(L, -1), once };
+	SignalState &state = GetSignalState(signal);
+	state.connections.push_back({ id, L, lua_ref(L, -1), once, parallel });
+	state.numListeners++;
 	lua_pop(L, 1);
+	numListeners++;
 
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 	if (udata->signalConnections) {
 		udata->signalConnections->AddConnection(this, signal, id);
 	}
+	udata->global->connections->AddConnection(this, signal, id);
 
 	return id;
 }
 
-bool SignalEmitter::IsConnected(const std::string &signal, uint64_t id) const {
-	auto conns = connections.find(signal);
-	if (conns == connections.end()) {
-		return false;
+int SignalEmitter::FindConnection(int signal, uint64_t id) const {
+	const SignalState *state = FindSignalState(signal);
+	if (!state) {
+		return -1;
 	}
 
-	return conns->second.contains(id);
+	const std::vector<Connection> &conns = state->connections;
+	auto it = std::lower_bound(conns.begin(), conns.end(), id, [](const Connection &conn, uint64_t value) {
+		return conn.id < value;
+	});
+
+	if (it == conns.end() || it->id != id || it->ref == LUA_NOREF) {
+		return -1;
+	}
+
+	return it - conns.begin();
+}
+
+void SignalEmitter::EndIteration(int signal) {
+	SignalState &state = *FindSignalState(signal);
+	if (--state.iterating > 0 || !state.hasTombstones) {
+		return;
+	}
+
+	std::erase_if(state.connections, [](const Connection &conn) {
+		return conn.ref == LUA_NOREF;
+	});
+
+	state.hasTombstones = false;
 }
 
-void SignalEmitter::Disconnect(const std::string &signal, uint64_t id, bool cancel, bool updateOwner) {
-	auto it = connections[signal].find(id);
-	if (it != connections[signal].end()) {
-		const Connection &conn = connections[signal][id];
+bool SignalEmitter::IsConnected(int signal, uint64_t id) const {
+	return FindConnection(signal, id) >= 0;
+}
+
+void SignalEmitter::Disconnect(int signal, uint64_t id, bool cancel, bool updateOwner) {
+	int index = FindConnection(signal, id);
+	if (index < 0) {
+		return;
+	}
 
-		SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
-		if (updateOwner && udata->signalConnections) {
+	SignalState &state = *FindSignalState(signal);
+	Connection &conn = state.connections[index];
+
+	SbxThreadData *udata = luaSBX_getthreaddata(conn.L);
+	if (updateOwner) {
+		if (udata->signalConnections) {
 			udata->signalConnections->RemoveConnection(this, id);
 		}
-		if (cancel && udata->global->scheduler) {
-			udata->global->scheduler->CancelEvents(this, id);
-		}
+		udata->global->connections->RemoveConnection(this, id);
+	}
+	if (cancel && udata->global->scheduler) {
+		udata->global->scheduler->CancelEvents(this, id);
+	}
 
-		lua_unref(conn.L, conn.ref);
-		connections[signal].erase(id);
+	lua_unref(conn.L, conn.ref);
+	state.numListeners--;
+	numListeners--;
+
+	if (state.iterating > 0) {
+		// Erased once all Emit calls are done with the vector
+		conn.ref = LUA_NOREF;
+		state.hasTombstones = true;
+	} else {
+		state.connections.erase(state.connections.begin() + index);
 	}
 }
 
-int SignalEmitter::Wait(const std::string &signal, lua_State *L) {
+int SignalEmitter::Wait(int signal, lua_State *L) {
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 	if (!udata->global->scheduler) {
 		luaSBX_noschederror(L);
 	}
 
-	SignalWaitTask *task = new SignalWaitTask(L);
+	SignalWaitTask *task = new SignalWaitTask(L, this, signal);
 	udata->global->scheduler->AddTask(task);
-	pendingTasks[signal].push_back(task);
+	SignalState &state = GetSignalState(signal);
+	state.pendingTasks.push_back(task);
+	state.numListeners++;
+	numListeners++;
 
 	return lua_yield(L, 0);
 }
 
+void SignalEmitter::RemovePendingTask(int signal, SignalWaitTask *task) {
+	SignalState &state = *FindSignalState(signal);
+	state.pendingTasks.remove(task);
+	state.numListeners--;
+	numListeners--;
+}
+
 int SignalEmitter::NumConnections() const {
 	int total = 0;
-	for (const auto &[emitter, conns] : connections) {
-		total += conns.size();
+	for (const SignalState &state : signals) {
+		for (const Connection &conn : state.connections) {
+			if (conn.ref != LUA_NOREF) {
+				total++;
+			}
+		}
 	}
 	return total;
 }
 
 void SignalConnectionOwner::Clear() {
-	for (const auto &[emitter, conns] : connections) {
-		for (const auto &[id, connName] : conns) {
-			emitter->Disconnect(connName, id, true, false);
+	// Taken first, since connections may also be tracked by another owner
+	// which is updated as they are disconnected
+	std::unordered_map<SignalEmitter *, std::unordered_map<uint64_t, int>> cleared;
+	cleared.swap(connections);
+
+	for (const auto &[emitter, conns] : cleared) {
+		for (const auto &[id, signal] : conns) {
+			emitter->Disconnect(signal, id, true, true);
 		}
 	}
-
-	connections.clear();
 }
 
 void SignalConnectionOwner::ClearEmitter(SignalEmitter *emitter) {
 	connections.erase(emitter);
 }
 
-void SignalConnectionOwner::AddConnection(SignalEmitter *emitter, const std::string &name, uint64_t id) {
-	connections[emitter][id] = name;
+void SignalConnectionOwner::AddConnection(SignalEmitter *emitter, int signal, uint64_t id) {
+	connections[emitter][id] = signal;
 }
 
 void SignalConnectionOwner::RemoveConnection(SignalEmitter *emitter, uint64_t id) {
-	connections[emitter].erase(id);
+	auto it = connections.find(emitter);
+	if (it == connections.end()) {
+		return;
+	}
+
+	it->second.erase(id);
+	if (it->second.empty()) {
+		connections.erase(it);
+	}
+}
+
+SignalWaitTask::SignalWaitTask(lua_State *T, SignalEmitter *emitter, int signal) :
+		ScheduledTask(T), emitter(emitter), signal(signal) {
+}
+
+SignalWaitTask::~SignalWaitTask() {
+	if (emitter) {
+		emitter->RemovePendingTask(signal, this);
+	}
 }
 
 bool SignalWaitTask::IsComplete(ResumptionPoint /*point*/) {
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/Runtime/SlabAllocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace SBX {
+
+SlabAllocator::~SlabAllocator() {
+	for (void *page : pages) {
+		free(page);
+	}
+}
+
+void *SlabAllocator::Alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	SlabAllocator *self = static_cast<SlabAllocator *>(ud);
+
+#ifndef NDEBUG
+	bool wasBusy = self->busy.exchange(true, std::memory_order_acquire);
+	assert(!wasBusy && "SlabAllocator used by two threads at once");
+	(void)wasBusy;
+#endif
+
+	void *block = nullptr;
+
+	if (nsize == 0) {
+		if (ptr) {
+			self->Free(ptr, osize);
+		}
+	} else if (!ptr) {
+		block = self->Allocate(nsize);
+	} else {
+		block = self->Reallocate(ptr, osize, nsize);
+	}
+
+#ifndef NDEBUG
+	self->busy.store(false, std::memory_order_release);
+#endif
+
+	return block;
+}
+
+size_t SlabAllocator::GetSizeClass(size_t size) {
+	return (size + SLAB_GRANULARITY - 1) / SLAB_GRANULARITY - 1;
+}
+
+void *SlabAllocator::Carve(size_t sizeClass) {
+	size_t classSize = GetClassSize(sizeClass);
+
+	// The rest of the current page is abandoned if too small
+	if (static_cast<size_t>(pageEnd - pageCursor) < classSize) {
+		char *page = static_cast<char *>(malloc(SLAB_PAGE_SIZE));
+		if (!page) {
+			return nullptr;
+		}
+
+		pages.push_back(page);
+		stats.pageBytes += SLAB_PAGE_SIZE;
+
+		pageCursor = page;
+		pageEnd = page + SLAB_PAGE_SIZE;
+	}
+
+	void *block = pageCursor;
+	pageCursor += classSize;
+	return block;
+}
+
+void *SlabAllocator::Allocate(size_t size) {
+	size_t sizeClass = GetSizeClass(size);
+	if (sizeClass >= SLAB_CLASSES) {
+		void *block = malloc(size);
+		if (block) {
+			stats.largeBytes += size;
+		}
+
+		return block;
+	}
+
+	void *block = freeLists[sizeClass];
+	if (block) {
+		freeLists[sizeClass] = freeLists[sizeClass]->next;
+	} else {
+		block = Carve(sizeClass);
+		if (!block) {
+			return nullptr;
+		}
+	}
+
+	stats.liveBytes[sizeClass] += size;
+	stats.liveBlocks[sizeClass]++;
+	return block;
+}
+
+void *SlabAllocator::Reallocate(void *ptr, size_t osize, size_t nsize) {
+	size_t oldClass = GetSizeClass(osize);
+	size_t newClass = GetSizeClass(nsize);
+
+	if (oldClass >= SLAB_CLASSES && newClass >= SLAB_CLASSES) {
+		void *block = realloc(ptr, nsize);
+		if (block) {
+			stats.largeBytes = stats.largeBytes - osize + nsize;
+		}
+
+		return block;
+	}
+
+	if (oldClass == newClass) {
+		stats.liveBytes[oldClass] = stats.liveBytes[oldClass] - osize + nsize;
+		return ptr;
+	}
+
+	void *block = Allocate(nsize);
+	if (!block) {
+		return nullptr;
+	}
+
+	memcpy(block, ptr, std::min(osize, nsize));
+	Free(ptr, osize);
+	return block;
+}
+
+void SlabAllocator::Free(void *ptr, size_t size) {
+	size_t sizeClass = GetSizeClass(size);
+	if (sizeClass >= SLAB_CLASSES) {
+		free(ptr);
+		stats.largeBytes -= size;
+		return;
+	}
+
+	FreeBlock *block = static_cast<FreeBlock *>(ptr);
+	block->next = freeLists[sizeClass];
+	freeLists[sizeClass] = block;
+
+	stats.liveBytes[sizeClass] -= size;
+	stats.liveBlocks[sizeClass]--;
+}
+
+size_t SlabAllocator::GetLiveBytes() const {
+	size_t total = stats.largeBytes;
+	for (size_t bytes : stats.liveBytes) {
+		total += bytes;
+	}
+
+	return total;
+}
+
+} //namespace SBX
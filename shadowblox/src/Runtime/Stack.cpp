@@ -15,8 +15,10 @@
 #include "Sbx/Runtime/Stack.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "lua.h"
 #include "lualib.h"
@@ -146,11 +148,13 @@ const std::string LuauStackOp<int64_t>::NAME = "int64";
 /* STRING */
 
 void LuauStackOp<std::string>::Push(lua_State *L, const std::string &value) {
-	lua_pushstring(L, value.c_str());
+	lua_pushlstring(L, value.data(), value.size());
 }
 
 std::string LuauStackOp<std::string>::Get(lua_State *L, int index) {
-	return lua_tostring(L, index);
+	size_t len;
+	const char *str = lua_tolstring(L, index, &len);
+	return std::string(str, len);
 }
 
 bool LuauStackOp<std::string>::Is(lua_State *L, int index) {
@@ -158,7 +162,9 @@ bool LuauStackOp<std::string>::Is(lua_State *L, int index) {
 }
 
 std::string LuauStackOp<std::string>::Check(lua_State *L, int index) {
-	return luaL_checkstring(L, index);
+	size_t len;
+	const char *str = luaL_checklstring(L, index, &len);
+	return std::string(str, len);
 }
 
 const std::string LuauStackOp<std::string>::NAME = "string";
@@ -170,4 +176,26 @@ const char *LuauStackOp<const char *>::Check(lua_State *L, int index) { return l
 
 const std::string LuauStackOp<const char *>::NAME = "string";
 
+void LuauStackOp<std::string_view>::Push(lua_State *L, const std::string_view &value) {
+	lua_pushlstring(L, value.data(), value.size());
+}
+
+std::string_view LuauStackOp<std::string_view>::Get(lua_State *L, int index) {
+	size_t len;
+	const char *str = lua_tolstring(L, index, &len);
+	return { str, len };
+}
+
+bool LuauStackOp<std::string_view>::Is(lua_State *L, int index) {
+	return lua_isstring(L, index);
+}
+
+std::string_view LuauStackOp<std::string_view>::Check(lua_State *L, int index) {
+	size_t len;
+	const char *str = luaL_checklstring(L, index, &len);
+	return { str, len };
+}
+
+const std::string LuauStackOp<std::string_view>::NAME = "string";
+
 } //namespace SBX
@@ -14,9 +14,13 @@
 
 #include "Sbx/Runtime/TaskScheduler.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "lua.h"
 #include "lualib.h"
@@ -24,134 +28,496 @@
 #include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/LuauRuntime.hpp"
 #include "Sbx/Runtime/SignalEmitter.hpp"
+#include "Sbx/Runtime/ThreadPool.hpp"
 
 #include "Sbx/Runtime/WaitTask.hpp"
 
 namespace SBX {
 
+#define TASK_POOL_GRANULARITY 16
+#define TASK_POOL_CLASSES 16 // up to 256 bytes
+#define TASK_POOL_MAX_FREE 1024 // per class
+
+struct TaskPool {
+	std::vector<void *> free[TASK_POOL_CLASSES];
+
+	~TaskPool() {
+		for (std::vector<void *> &blocks : free) {
+			for (void *block : blocks) {
+				::operator delete(block);
+			}
+		}
+	}
+};
+
+static thread_local TaskPool taskPool;
+
+thread_local TaskScheduler *TaskScheduler::parallelScheduler = nullptr;
+
+static size_t luaSBX_taskpoolclass(size_t size) {
+	return (size + TASK_POOL_GRANULARITY - 1) / TASK_POOL_GRANULARITY - 1;
+}
+
 ScheduledTask::ScheduledTask(lua_State *T) :
 		T(T) {
 	// Prevent thread collection while yielded
-	lua_pushthread(T);
-	threadRef = lua_ref(T, -1);
-	lua_pop(T, 1);
+	threadSlot = luaSBX_refthread(T);
 }
 
 ScheduledTask::~ScheduledTask() {
-	lua_unref(T, threadRef);
+	luaSBX_unrefthread(T, threadSlot);
+}
+
+void *ScheduledTask::operator new(size_t size) {
+	size_t sizeClass = luaSBX_taskpoolclass(size);
+	if (sizeClass >= TASK_POOL_CLASSES) {
+		return ::operator new(size);
+	}
+
+	std::vector<void *> &blocks = taskPool.free[sizeClass];
+	if (blocks.empty()) {
+		return ::operator new((sizeClass + 1) * TASK_POOL_GRANULARITY);
+	}
+
+	void *block = blocks.back();
+	blocks.pop_back();
+	return block;
+}
+
+void ScheduledTask::operator delete(void *ptr, size_t size) {
+	size_t sizeClass = luaSBX_taskpoolclass(size);
+	if (sizeClass >= TASK_POOL_CLASSES || taskPool.free[sizeClass].size() >= TASK_POOL_MAX_FREE) {
+		::operator delete(ptr);
+		return;
+	}
+
+	taskPool.free[sizeClass].push_back(ptr);
 }
 
 TaskScheduler::TaskScheduler(LuauRuntime *runtime) :
-		runtime(runtime) {
+		runtime(runtime),
+		gcPacing(VMMax) {
+}
+
+void TaskScheduler::SetRuntime(LuauRuntime *value) {
+	runtime = value;
+	gcPacing.assign(VMMax, GCPacing{});
 }
 
 void TaskScheduler::Resume(ResumptionPoint point, uint64_t frame, double delta, double throttleThreshold) {
 	double start = lua_clock();
+	time += delta;
+
+	double budget = budgets[static_cast<size_t>(point)] * 1e-6;
+	bool resumedAny = false;
+
+	auto canResume = [&](ScheduledTask *task) {
+		double elapsed = lua_clock() - start;
+		return (budget <= 0.0 || !resumedAny || elapsed < budget) &&
+				(!task->CanThrottle() || elapsed < throttleThreshold);
+	};
+
+	// Only timers which are due are visited. Timers added while resuming are
+	// not considered until the next call.
+	while (!timers.empty() && timers.front().wakeTime <= time) {
+		std::pop_heap(timers.begin(), timers.end(), std::greater<>());
+		dueTimers.push_back(timers.back());
+		timers.pop_back();
+	}
+
+	for (size_t i = 0; i < dueTimers.size(); i++) {
+		// Cleared if cancelled during a previous resumption
+		WaitTask *task = dueTimers[i].task;
+		if (!task) {
+			continue;
+		}
+
+		dueTimers[i].task = nullptr;
+		task->SetTime(frame, time);
+
+		if (canResume(task) && task->IsComplete(point)) {
+			if (task->ShouldResume()) {
+				int nret = task->PushResults();
+				ResumeThread(task->GetThread(), nret);
+				resumedAny = true;
+			}
+
+			delete task;
+		} else {
+			// Retry next time. Keeping the original order means tasks which
+			// spill over are resumed first.
+			timers.push_back({ task->GetWakeTime(), dueTimers[i].order, task });
+			std::push_heap(timers.begin(), timers.end(), std::greater<>());
+		}
+	}
+
+	dueTimers.clear();
+
+	// First task skipped for lack of budget, which is rotated to the front
+	auto spillover = tasks.end();
+
+	// Resumed threads can cancel any task, so entries are only cleared until
+	// the loop is done. This keeps it and spillover valid.
+	resumingTasks = true;
 
 	auto it = tasks.begin();
 	while (it != tasks.end()) {
 		ScheduledTask *task = *it;
+		if (!task) {
+			it++;
+			continue;
+		}
 
 		// Do not throttle update (for now) to ensure delta accumulation is
 		// correct
 		task->Update(frame, delta);
 
-		if ((!task->CanThrottle() || lua_clock() - start < throttleThreshold) &&
-				task->IsComplete(point)) {
+		if (canResume(task) && task->IsComplete(point)) {
+			// Cleared first, as the thread may be cancelled while running
+			*it = nullptr;
+
 			if (task->ShouldResume()) {
 				int nret = task->PushResults();
-				luaSBX_resume(task->GetThread(), nullptr, nret);
+				ResumeThread(task->GetThread(), nret);
+				resumedAny = true;
 			}
 
-			delete *it;
-
-			auto toRemove = it;
+			delete task;
 			it++;
-			tasks.erase(toRemove);
 
 			continue;
 		}
 
+		if (spillover == tasks.end() && budget > 0.0 && lua_clock() - start >= budget) {
+			spillover = it;
+		}
+
 		it++;
 	}
 
-	// NOTE: Must be careful as this list can be modified during iteration if
-	// CancelEvents is called from Disconnect. To avoid memory problems from
-	// deleting the DeferredEvent, move each item out of the list and remove
-	// the entry before calling resume.
-	while (!deferredEvents.empty()) {
-		DeferredEvent ev = std::move(deferredEvents.front());
-		deferredEvents.pop_front();
+	resumingTasks = false;
+
+	if (spillover != tasks.end()) {
+		tasks.splice(tasks.end(), tasks, tasks.begin(), spillover);
+	}
+
+	tasks.remove(nullptr);
+
+	// NOTE: The queue can be modified during iteration if CancelEvents is
+	// called from Disconnect, or grow if handlers fire more events. Take each
+	// event out of the queue before calling resume.
+	while (eventCount > 0) {
+		DeferredEvent &slot = events[eventHead];
+		eventHead = (eventHead + 1) & (events.size() - 1);
+		eventCount--;
+
+		if (!slot.L) {
+			continue;
+		}
+
+		DeferredCallback resume = std::move(slot.resume);
+		slot.L = nullptr;
+		numPendingEvents--;
 
-		currentReentrancy = std::move(ev.pathReentrancy);
-		ev.resume();
+		currentEvent = slot.node;
+		resume();
 	}
 
-	currentReentrancy.clear();
+	currentEvent = -1;
+	eventNodes.clear();
+
+	RunParallelPhase();
+}
+
+void TaskScheduler::ResumeThread(lua_State *T, int nargs) {
+	// Threads which yielded while desynchronized continue in parallel
+	if (luaSBX_getthreaddata(T)->desynchronized) {
+		AddParallelThread(T, nargs);
+	} else {
+		luaSBX_resume(T, nullptr, nargs);
+	}
 }
 
-void TaskScheduler::GCStep(double delta) {
-	int32_t gcNewSize[VMMax];
-	runtime->GCSize(gcNewSize);
+void TaskScheduler::RunParallelPhase() {
+	{
+		// Threads desynchronized during this phase wait for the next one
+		std::lock_guard<std::mutex> lock(mutex);
+		parallelBatch.swap(parallelTasks);
+	}
 
-	for (int i = 0; i < VMMax; i++) {
-		gcSizeRate[i] = (int32_t)((gcNewSize[i] - gcLastSize[i]) / delta);
-		gcLastSize[i] = gcNewSize[i];
+	if (parallelBatch.empty()) {
+		return;
 	}
 
-	runtime->GCStep(gcCollectRate, delta);
+	// A VM runs one thread at a time, so each VM's threads form one job
+	std::vector<SbxGlobalThreadData *> vms;
+	std::vector<std::vector<size_t>> jobs;
+
+	for (size_t i = 0; i < parallelBatch.size(); i++) {
+		SbxGlobalThreadData *vm = luaSBX_getthreaddata(parallelBatch[i].T)->global;
+
+		auto it = std::find(vms.begin(), vms.end(), vm);
+		if (it == vms.end()) {
+			vm->parallelPhase = true;
+			vms.push_back(vm);
+			jobs.emplace_back();
+			it = vms.end() - 1;
+		}
+
+		jobs[it - vms.begin()].push_back(i);
+	}
+
+	auto runJob = [&](size_t job) {
+		parallelScheduler = this;
+
+		for (size_t i : jobs[job]) {
+			// Cleared if cancelled during a previous resumption
+			ScheduledTask *task = parallelBatch[i].task;
+			if (!task) {
+				continue;
+			}
+
+			parallelBatch[i].task = nullptr;
+
+			lua_State *T = task->GetThread();
+			luaSBX_getthreaddata(T)->desynchronized = true;
+
+			int nret = task->PushResults();
+			luaSBX_resume(T, nullptr, nret);
+
+			delete task;
+		}
+
+		parallelScheduler = nullptr;
+	};
+
+	if (threadPool && jobs.size() > 1) {
+		threadPool->Run(jobs.size(), runJob);
+	} else {
+		for (size_t job = 0; job < jobs.size(); job++) {
+			runJob(job);
+		}
+	}
+
+	parallelBatch.clear();
+
+	for (SbxGlobalThreadData *vm : vms) {
+		vm->parallelPhase = false;
+	}
+
+	// Workers are done, so the queue can be taken without locking
+	std::vector<DeferredCallback> callbacks;
+	callbacks.swap(serialCallbacks);
+
+	for (DeferredCallback &callback : callbacks) {
+		callback();
+	}
+
+	// Objects released by workers are destroyed on this thread
+	for (SbxGlobalThreadData *vm : vms) {
+		vm->parallelReleases.clear();
+	}
+}
+
+void TaskScheduler::DeferSerial(DeferredCallback &&callback) {
+	std::lock_guard<std::mutex> lock(mutex);
+	serialCallbacks.push_back(std::move(callback));
+}
+
+void TaskScheduler::GCStep(double delta, double spareTime) {
+	if (delta <= 0.0) {
+		return;
+	}
+
+	// Actors are never closed before the runtime, so their index is stable.
+	// Ones created since the last step start with fresh pacing.
+	size_t numVMs = VMMax + runtime->NumActors();
+	gcPacing.resize(numVMs);
+
+	auto getVM = [&](size_t i) {
+		return i < VMMax ? runtime->GetVM(VMType(i)) : runtime->GetActor(i - VMMax);
+	};
+
+	for (size_t i = 0; i < numVMs; i++) {
+		GCPacing &gc = gcPacing[i];
+		int32_t newSize = lua_gc(getVM(i), LUA_GCCOUNT, 0);
+		gc.sizeRate = (int32_t)((newSize - gc.lastSize) / delta);
+		gc.lastSize = newSize;
+	}
+
+	double budget = gcBudget * 1e-6 + std::max(spareTime, 0.0) / numVMs;
+
+	for (size_t i = 0; i < numVMs; i++) {
+		GCPacing &gc = gcPacing[i];
 
-	for (int i = 0; i < VMMax; i++) {
-		uint32_t collRate = gcCollectRate[i];
-		int32_t sizeRate = gcSizeRate[i];
+		// Collection is owed at the current rate, and bounded so that a long
+		// stretch over budget cannot turn into a spike later
+		gc.debt = std::min(gc.debt + gc.collectRate * delta, (double)GC_RATE_MAX);
+
+		double step = gc.debt;
+		if (gcBudget > 0) {
+			// Predicted from the measured cost of previous steps
+			step = std::min(step, budget / gc.costPerKB);
+		}
+
+		gc.stepSize = (uint32_t)step;
+		gc.time = 0.0;
+
+		if (gc.stepSize == 0) {
+			continue;
+		}
+
+		gc.time = LuauRuntime::GCStep(getVM(i), gc.stepSize);
+		gc.debt -= gc.stepSize;
+
+		double cost = std::max(gc.time / gc.stepSize, GC_COST_MIN);
+		gc.costPerKB += GC_COST_SMOOTHING * (cost - gc.costPerKB);
+	}
+
+	for (GCPacing &gc : gcPacing) {
+		uint32_t collRate = gc.collectRate;
+		int32_t sizeRate = gc.sizeRate;
 
 		if (sizeRate > 0 && (uint32_t)sizeRate > collRate) {
 			// Usage increasing faster than collection
 			if (collRate + GC_RATE_INC > GC_RATE_MAX) {
-				gcCollectRate[i] = GC_RATE_MAX;
+				gc.collectRate = GC_RATE_MAX;
 			} else {
-				gcCollectRate[i] += GC_RATE_INC;
+				gc.collectRate += GC_RATE_INC;
 			}
 		} else {
 			// Usage increasing slower than collection
 			if (collRate < GC_RATE_MIN + GC_RATE_INC) {
-				gcCollectRate[i] = GC_RATE_MIN;
+				gc.collectRate = GC_RATE_MIN;
 			} else {
-				gcCollectRate[i] -= GC_RATE_INC;
+				gc.collectRate -= GC_RATE_INC;
 			}
 		}
 	}
 }
 
 void TaskScheduler::AddTask(ScheduledTask *task) {
+	std::lock_guard<std::mutex> lock(mutex);
 	tasks.push_back(task);
 }
 
-bool TaskScheduler::AddDeferredEvent(SignalEmitter *emitter, uint64_t id, lua_State *L, std::function<void()> resume) {
-	if (currentReentrancy[emitter][id] >= DEFERRED_EVENT_REENTRANCY_LIMIT) {
-		return false;
+void TaskScheduler::AddTimer(WaitTask *task) {
+	std::lock_guard<std::mutex> lock(mutex);
+	timers.push_back({ task->GetWakeTime(), nextTimerOrder++, task });
+	std::push_heap(timers.begin(), timers.end(), std::greater<>());
+}
+
+void TaskScheduler::AddParallelThread(lua_State *T, int nargs) {
+	ScheduledTask *task = new DeferTask(T, nargs);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	parallelTasks.push_back({ T, task });
+}
+
+int TaskScheduler::AddEventNode(const void *emitter, uint64_t id) {
+	// Reentrancy of (emitter, id) is recorded on its nearest occurrence
+	int count = 0;
+	for (int node = currentEvent; node >= 0; node = eventNodes[node].parent) {
+		const EventNode &ev = eventNodes[node];
+		if (ev.emitter == emitter && ev.id == id) {
+			count = ev.count;
+			break;
+		}
+	}
+
+	if (count >= DEFERRED_EVENT_REENTRANCY_LIMIT) {
+		return -1;
 	}
 
-	auto childReentrancy = currentReentrancy;
-	childReentrancy[emitter][id]++;
+	eventNodes.push_back({ emitter, id, currentEvent, count + 1 });
+	return static_cast<int>(eventNodes.size()) - 1;
+}
+
+void TaskScheduler::PushEvent(DeferredEvent &&ev) {
+	if (eventCount == events.size()) {
+		std::vector<DeferredEvent> newEvents(events.empty() ? 16 : events.size() * 2);
+		for (size_t i = 0; i < eventCount; i++) {
+			newEvents[i] = std::move(events[(eventHead + i) & (events.size() - 1)]);
+		}
 
-	deferredEvents.push_back({ emitter,
-			id,
-			L,
-			std::move(resume),
-			std::move(childReentrancy) });
+		events = std::move(newEvents);
+		eventHead = 0;
+	}
 
-	return true;
+	events[(eventHead + eventCount) & (events.size() - 1)] = std::move(ev);
+	eventCount++;
+	numPendingEvents++;
+}
+
+template <typename F>
+void TaskScheduler::CancelEventsIf(F pred) {
+	for (size_t i = 0; i < eventCount; i++) {
+		DeferredEvent &ev = events[(eventHead + i) & (events.size() - 1)];
+		if (ev.L && pred(ev)) {
+			ev.L = nullptr;
+			ev.resume.Reset();
+			numPendingEvents--;
+		}
+	}
+}
+
+template <typename F>
+void TaskScheduler::CancelTimers(F pred) {
+	auto last = std::remove_if(timers.begin(), timers.end(), [&](const Timer &timer) {
+		return pred(timer.task);
+	});
+
+	if (last != timers.end()) {
+		timers.erase(last, timers.end());
+		std::make_heap(timers.begin(), timers.end(), std::greater<>());
+	}
+
+	for (Timer &timer : dueTimers) {
+		if (timer.task && pred(timer.task)) {
+			timer.task = nullptr;
+		}
+	}
+}
+
+template <typename F>
+void TaskScheduler::CancelTasksIf(F pred) {
+	for (ScheduledTask *&task : tasks) {
+		if (task && pred(task)) {
+			task = nullptr;
+		}
+	}
+
+	// Otherwise erased once Resume is done iterating
+	if (!resumingTasks) {
+		tasks.remove(nullptr);
+	}
 }
 
 void TaskScheduler::CancelTask(ScheduledTask *task) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	CancelTimers([=](WaitTask *timer) {
+		return timer == task;
+	});
+
+	CancelTasksIf([=](ScheduledTask *other) {
+		return other == task;
+	});
+
 	delete task;
-	tasks.remove(task);
 }
 
-void TaskScheduler::CancelThread(lua_State *L) {
-	// May be relevant in case of a destroyed Actor
-	tasks.remove_if([=](ScheduledTask *task) {
+void TaskScheduler::RemoveTasks(lua_State *L) {
+	CancelTasksIf([=](ScheduledTask *task) {
+		if (task->GetThread() == L) {
+			delete task;
+			return true;
+		}
+
+		return false;
+	});
+
+	CancelTimers([=](WaitTask *task) {
 		if (task->GetThread() == L) {
 			delete task;
 			return true;
@@ -160,23 +526,102 @@ void TaskScheduler::CancelThread(lua_State *L) {
 		return false;
 	});
 
-	deferredEvents.remove_if([=](const DeferredEvent &ev) {
+	auto isThread = [=](const ParallelTask &entry) {
+		return entry.T == L;
+	};
+
+	parallelTasks.erase(std::remove_if(parallelTasks.begin(), parallelTasks.end(), [&](const ParallelTask &entry) {
+		if (isThread(entry)) {
+			delete entry.task;
+			return true;
+		}
+
+		return false;
+	}),
+			parallelTasks.end());
+
+	// Only the worker running L's VM can reach its entries in the batch
+	for (ParallelTask &entry : parallelBatch) {
+		if (isThread(entry) && entry.task) {
+			delete entry.task;
+			entry.task = nullptr;
+		}
+	}
+}
+
+void TaskScheduler::CancelTasks(lua_State *L) {
+	std::lock_guard<std::mutex> lock(mutex);
+	RemoveTasks(L);
+}
+
+void TaskScheduler::CancelThread(lua_State *L) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// May be relevant in case of a destroyed Actor
+	RemoveTasks(L);
+
+	CancelEventsIf([=](const DeferredEvent &ev) {
 		return ev.L == L;
 	});
 }
 
+void TaskScheduler::CancelVM(lua_State *L) {
+	std::lock_guard<std::mutex> lock(mutex);
+	lua_State *main = lua_mainthread(L);
+
+	CancelTasksIf([=](ScheduledTask *task) {
+		if (lua_mainthread(task->GetThread()) == main) {
+			delete task;
+			return true;
+		}
+
+		return false;
+	});
+
+	CancelTimers([=](WaitTask *task) {
+		if (lua_mainthread(task->GetThread()) == main) {
+			delete task;
+			return true;
+		}
+
+		return false;
+	});
+
+	parallelTasks.erase(std::remove_if(parallelTasks.begin(), parallelTasks.end(), [=](const ParallelTask &entry) {
+		if (lua_mainthread(entry.T) == main) {
+			delete entry.task;
+			return true;
+		}
+
+		return false;
+	}),
+			parallelTasks.end());
+
+	CancelEventsIf([=](const DeferredEvent &ev) {
+		return lua_mainthread(ev.L) == main;
+	});
+}
+
 void TaskScheduler::CancelEvents(SignalEmitter *emitter, uint64_t id) {
-	deferredEvents.remove_if([=](DeferredEvent &ev) {
+	CancelEventsIf([=](const DeferredEvent &ev) {
 		return ev.emitter == emitter && ev.id == id;
 	});
 }
 
+void TaskScheduler::SetBudget(ResumptionPoint point, uint32_t microseconds) {
+	budgets[static_cast<size_t>(point)] = microseconds;
+}
+
+uint32_t TaskScheduler::GetBudget(ResumptionPoint point) const {
+	return budgets[static_cast<size_t>(point)];
+}
+
 int TaskScheduler::NumPendingTasks() const {
-	return tasks.size();
+	return tasks.size() + timers.size() + parallelTasks.size();
 }
 
 int TaskScheduler::NumPendingEvents() const {
-	return deferredEvents.size();
+	return numPendingEvents;
 }
 
 static const luaL_Reg LEGACY_SCHEDULER_LIB[] = {
@@ -187,6 +632,12 @@ static const luaL_Reg LEGACY_SCHEDULER_LIB[] = {
 
 static const luaL_Reg SCHEDULER_LIB[] = {
 	{ "wait", luaSBX_taskwait },
+	{ "spawn", luaSBX_taskspawn },
+	{ "defer", luaSBX_taskdefer },
+	{ "delay", luaSBX_taskdelay },
+	{ "cancel", luaSBX_taskcancel },
+	{ "desynchronize", luaSBX_taskdesynchronize },
+	{ "synchronize", luaSBX_tasksynchronize },
 
 	{ nullptr, nullptr }
 };
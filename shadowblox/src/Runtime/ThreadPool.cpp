@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/Runtime/ThreadPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace SBX {
+
+ThreadPool::ThreadPool(int numWorkers) {
+	workers.reserve(numWorkers);
+	for (int i = 0; i < numWorkers; i++) {
+		workers.emplace_back(&ThreadPool::WorkerMain, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	wake.notify_all();
+
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::Run(size_t jobCount, const std::function<void(size_t)> &jobFunc) {
+	if (jobCount == 0) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &jobFunc;
+		count = jobCount;
+		next = 0;
+		remaining = jobCount;
+		batch++;
+	}
+
+	wake.notify_all();
+	RunJobs();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this]() { return remaining == 0; });
+	job = nullptr;
+}
+
+void ThreadPool::RunJobs() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (job && next < count) {
+		size_t index = next++;
+		const std::function<void(size_t)> *func = job;
+
+		lock.unlock();
+		(*func)(index);
+		lock.lock();
+
+		if (--remaining == 0) {
+			done.notify_all();
+		}
+	}
+}
+
+void ThreadPool::WorkerMain() {
+	uint64_t lastBatch = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&]() { return stopping || batch != lastBatch; });
+
+			if (stopping) {
+				return;
+			}
+
+			lastBatch = batch;
+		}
+
+		RunJobs();
+	}
+}
+
+} //namespace SBX
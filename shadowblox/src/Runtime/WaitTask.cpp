@@ -26,8 +26,8 @@ struct lua_State;
 
 namespace SBX {
 
-WaitTask::WaitTask(lua_State *T, double duration, bool legacyThrottling) :
-		ScheduledTask(T), elapsed(0.0), duration(duration), lastFrame(0), legacyThrottling(legacyThrottling) {
+WaitTask::WaitTask(lua_State *T, double startTime, double duration, bool legacyThrottling) :
+		ScheduledTask(T), startTime(startTime), elapsed(0.0), duration(duration), lastFrame(0), legacyThrottling(legacyThrottling) {
 }
 
 bool WaitTask::IsComplete(ResumptionPoint /*point*/) {
@@ -47,11 +47,19 @@ int WaitTask::PushResults() {
 	return 1;
 }
 
-void WaitTask::Update(uint64_t frame, double delta) {
-	elapsed += delta;
+void WaitTask::SetTime(uint64_t frame, double time) {
+	elapsed = time - startTime;
 	lastFrame = frame;
 }
 
+DelayTask::DelayTask(lua_State *T, double startTime, double duration, int nargs) :
+		WaitTask(T, startTime, duration, false), nargs(nargs) {
+}
+
+DeferTask::DeferTask(lua_State *T, int nargs) :
+		ScheduledTask(T), nargs(nargs) {
+}
+
 int luaSBX_wait(lua_State *L) {
 	SbxThreadData *udata = luaSBX_getthreaddata(L);
 	if (!udata->global->scheduler) {
@@ -59,8 +67,9 @@ int luaSBX_wait(lua_State *L) {
 	}
 
 	double duration = luaL_checknumber(L, 1);
-	WaitTask *task = new WaitTask(L, duration, true);
-	udata->global->scheduler->AddTask(task);
+	TaskScheduler *scheduler = udata->global->scheduler;
+	WaitTask *task = new WaitTask(L, scheduler->GetTime(), duration, true);
+	scheduler->AddTimer(task);
 
 	return lua_yield(L, 0);
 }
@@ -72,9 +81,129 @@ int luaSBX_taskwait(lua_State *L) {
 	}
 
 	double duration = luaL_checknumber(L, 1);
-	WaitTask *task = new WaitTask(L, duration, false);
-	udata->global->scheduler->AddTask(task);
+	TaskScheduler *scheduler = udata->global->scheduler;
+	WaitTask *task = new WaitTask(L, scheduler->GetTime(), duration, false);
+	scheduler->AddTimer(task);
+
+	return lua_yield(L, 0);
+}
+
+// Replaces the function or thread at index with the thread to resume, moving
+// the function onto a new thread if needed. Pending tasks of an existing thread
+// are cancelled so it is only resumed once.
+static lua_State *luaSBX_checktaskthread(lua_State *L, int index) {
+	if (lua_isfunction(L, index)) {
+		lua_State *T = lua_newthread(L);
+		lua_pushvalue(L, index);
+		lua_xmove(L, T, 1);
+		lua_replace(L, index);
+		return T;
+	}
+
+	if (!lua_isthread(L, index)) {
+		luaL_typeerrorL(L, index, "function or thread");
+	}
+
+	lua_State *T = lua_tothread(L, index);
+	int status = lua_costatus(L, T);
+	if (status == LUA_CORUN || status == LUA_CONOR) {
+		luaL_error(L, "cannot schedule a running thread");
+	}
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (udata->global->scheduler) {
+		udata->global->scheduler->CancelTasks(T);
+	}
+
+	return T;
+}
+
+int luaSBX_taskspawn(lua_State *L) {
+	int nargs = lua_gettop(L) - 1;
+	lua_State *T = luaSBX_checktaskthread(L, 1);
+
+	lua_xmove(L, T, nargs);
+	luaSBX_resume(T, L, nargs);
+
+	return 1;
+}
+
+int luaSBX_taskdefer(lua_State *L) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (!udata->global->scheduler) {
+		luaSBX_noschederror(L);
+	}
+
+	int nargs = lua_gettop(L) - 1;
+	lua_State *T = luaSBX_checktaskthread(L, 1);
+
+	lua_xmove(L, T, nargs);
+	udata->global->scheduler->AddTask(new DeferTask(T, nargs));
+
+	return 1;
+}
+
+int luaSBX_taskdelay(lua_State *L) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (!udata->global->scheduler) {
+		luaSBX_noschederror(L);
+	}
+
+	double duration = luaL_optnumber(L, 1, 0.0);
+	int nargs = lua_gettop(L) - 2;
+	lua_State *T = luaSBX_checktaskthread(L, 2);
+
+	lua_xmove(L, T, nargs);
+	TaskScheduler *scheduler = udata->global->scheduler;
+	scheduler->AddTimer(new DelayTask(T, scheduler->GetTime(), duration, nargs));
+
+	return 1;
+}
+
+int luaSBX_taskcancel(lua_State *L) {
+	luaL_checktype(L, 1, LUA_TTHREAD);
+	lua_State *T = lua_tothread(L, 1);
+
+	int status = lua_costatus(L, T);
+	if (status == LUA_CORUN || status == LUA_CONOR) {
+		luaL_error(L, "cannot cancel a running thread");
+	}
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (udata->global->scheduler) {
+		udata->global->scheduler->CancelThread(T);
+	}
+
+	lua_resetthread(T);
+	return 0;
+}
+
+int luaSBX_taskdesynchronize(lua_State *L) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (!udata->global->scheduler) {
+		luaSBX_noschederror(L);
+	}
+
+	if (udata->desynchronized) {
+		return 0;
+	}
+
+	udata->global->scheduler->AddParallelThread(L, 0);
+	return lua_yield(L, 0);
+}
+
+int luaSBX_tasksynchronize(lua_State *L) {
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	if (!udata->global->scheduler) {
+		luaSBX_noschederror(L);
+	}
+
+	if (!udata->desynchronized) {
+		return 0;
+	}
 
+	udata->desynchronized = false;
+	udata->global->scheduler->AddTask(new DeferTask(L, 0));
 	return lua_yield(L, 0);
 }
 
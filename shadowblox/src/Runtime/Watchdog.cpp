@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/Runtime/Watchdog.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace SBX {
+
+std::atomic<uint64_t> Watchdog::tick = 0;
+std::atomic<int> Watchdog::active = 0;
+
+Watchdog::Watchdog(uint32_t periodMs) :
+		periodMs(periodMs) {
+	tick.store(ReadClock(), std::memory_order_relaxed);
+	active.fetch_add(1, std::memory_order_relaxed);
+
+	thread = std::thread(&Watchdog::Run, this);
+}
+
+Watchdog::~Watchdog() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	wake.notify_one();
+	thread.join();
+
+	active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+uint64_t Watchdog::ReadClock() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+void Watchdog::Run() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (!wake.wait_for(lock, std::chrono::milliseconds(periodMs), [this]() { return stopping; })) {
+		// Read from the clock rather than counted, so late wakeups do not
+		// extend timeouts
+		tick.store(ReadClock(), std::memory_order_relaxed);
+	}
+}
+
+} //namespace SBX
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "Sbx/RuntimePool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "lua.h"
+
+#include "Sbx/Classes/ClassDB.hpp"
+#include "Sbx/Classes/DataModel.hpp"
+#include "Sbx/Classes/RunService.hpp"
+#include "Sbx/GodotBridge.hpp"
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/LuauRuntime.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
+
+namespace SBX {
+
+static void luaSBX_detachvm(lua_State *L) {
+	SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+
+	if (global->scheduler) {
+		global->scheduler->CancelVM(L);
+	}
+
+	global->scheduler = nullptr;
+	global->logger = nullptr;
+}
+
+PooledRuntime::~PooledRuntime() {
+	// Objects may still be referenced by the VMs. Objects outliving them (e.g.,
+	// held by the host) are disconnected from them as they close.
+	runtime.reset();
+	dataModel.reset();
+}
+
+RuntimePool::RuntimePool(size_t size, void (*initCallback)(lua_State *), bool debug, bool slabAllocator, bool freezeSharedState) :
+		size(size), initCallback(initCallback), debug(debug), slabAllocator(slabAllocator), freezeSharedState(freezeSharedState) {
+	if (size > 0) {
+		ready.push_back(Create());
+	}
+
+	if (freezeSharedState) {
+		Classes::ClassDB::Freeze();
+		luaSBX_freezeatoms();
+	}
+
+	thread = std::thread(&RuntimePool::Run, this);
+}
+
+RuntimePool::~RuntimePool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	wake.notify_one();
+	thread.join();
+
+	if (freezeSharedState) {
+		Classes::ClassDB::Unfreeze();
+		luaSBX_unfreezeatoms();
+	}
+}
+
+std::unique_ptr<PooledRuntime> RuntimePool::Create() const {
+	std::unique_ptr<PooledRuntime> entry = std::make_unique<PooledRuntime>();
+	entry->runtime = std::make_unique<LuauRuntime>(initCallback, debug, slabAllocator);
+	entry->dataModel = Bridge::CreateDataModel();
+	Bridge::RegisterGlobals(entry->runtime->GetVM(UserVM), entry->dataModel);
+
+	return entry;
+}
+
+std::unique_ptr<PooledRuntime> RuntimePool::Acquire() {
+	std::unique_ptr<PooledRuntime> entry;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!ready.empty()) {
+			entry = std::move(ready.back());
+			ready.pop_back();
+		}
+	}
+
+	wake.notify_one();
+
+	if (!entry) {
+		entry = Create();
+	}
+
+	return entry;
+}
+
+void RuntimePool::Release(std::unique_ptr<PooledRuntime> entry) {
+	if (!entry) {
+		return;
+	}
+
+	if (entry->dataModel) {
+		std::shared_ptr<Classes::RunService> runService = entry->dataModel->GetRunService();
+		if (runService) {
+			runService->Stop();
+			runService->SetScheduler(nullptr);
+		}
+	}
+
+	for (int i = 0; i < VMMax; i++) {
+		luaSBX_detachvm(entry->runtime->GetVM(VMType(i)));
+	}
+
+	for (size_t i = 0; i < entry->runtime->NumActors(); i++) {
+		luaSBX_detachvm(entry->runtime->GetActor(i));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		released.push_back(std::move(entry));
+	}
+
+	wake.notify_one();
+}
+
+size_t RuntimePool::NumReady() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return ready.size();
+}
+
+size_t RuntimePool::GetPageBytes() const {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	size_t total = 0;
+	for (const std::unique_ptr<PooledRuntime> &entry : ready) {
+		total += entry->runtime->GetPageBytes();
+	}
+
+	return total;
+}
+
+void RuntimePool::Run() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true) {
+		wake.wait(lock, [this]() {
+			return stopping || !released.empty() || ready.size() < size;
+		});
+
+		if (stopping) {
+			break;
+		}
+
+		if (!released.empty()) {
+			std::unique_ptr<PooledRuntime> entry = std::move(released.back());
+			released.pop_back();
+
+			lock.unlock();
+			entry.reset();
+			lock.lock();
+
+			continue;
+		}
+
+		lock.unlock();
+		std::unique_ptr<PooledRuntime> entry = Create();
+		lock.lock();
+
+		ready.push_back(std::move(entry));
+	}
+}
+
+} //namespace SBX
@@ -19,9 +19,17 @@
 #include "godot_cpp/classes/node.hpp"
 #include "godot_cpp/core/class_db.hpp"
 
+#include "Sbx/Runtime/CompileOptions.hpp"
+
 namespace SBX {
 class LuauRuntime;
+class RuntimePool;
+struct PooledRuntime;
 class Logger;
+class BytecodeCache;
+class TaskScheduler;
+class ThreadPool;
+class Watchdog;
 }
 
 namespace SBX::Classes {
@@ -55,7 +63,7 @@ public:
 	void _exit_tree() override;
 
 	// Runtime access
-	SBX::LuauRuntime *get_runtime() const { return runtime.get(); }
+	SBX::LuauRuntime *get_runtime() const { return runtime; }
 
 	// DataModel access
 	std::shared_ptr<SBX::Classes::DataModel> get_data_model() const { return dataModel; }
@@ -63,8 +71,16 @@ public:
 	std::shared_ptr<SBX::Classes::Players> get_players() const;
 	std::shared_ptr<SBX::Classes::RunService> get_run_service() const;
 
-	// Execute a Luau script
-	godot::String execute_script(const godot::String &code);
+	// Swap in a fresh runtime and DataModel, e.g. going from the lobby to a
+	// match. Scripts, players and instances of the previous ones are dropped.
+	void restart_runtime();
+
+	// Execute a Luau script, in the user VM or the given actor
+	godot::String execute_script(const godot::String &code, int actor = -1);
+
+	// Create an actor: a VM of its own, whose desynchronized threads run
+	// concurrently with those of other VMs. Returns its index.
+	int create_actor();
 
 	// Execute a script with the 'script' global set
 	godot::String run_script(const godot::String &code, SbxPart *script_parent);
@@ -80,6 +96,18 @@ public:
 	void gc_step(int step_size);
 	int get_gc_memory() const;
 
+	// Bytecode cache hit/miss counts, for startup profiling
+	godot::Dictionary get_bytecode_cache_stats() const;
+
+	// Compile profile for scripts: 0 debug, 1 release (default)
+	void set_compile_profile(int profile);
+	int get_compile_profile() const { return static_cast<int>(compileProfile); }
+
+	// Native code generation: 0 disabled, 1 --!native and hot scripts, 2 all
+	// scripts. Scripts are hot once they use hot_threshold seconds of CPU.
+	void set_native_mode(int mode, double hot_threshold);
+	godot::Dictionary get_native_stats() const;
+
 	// Singleton access
 	static SbxRuntime *get_singleton() { return singleton; }
 
@@ -119,17 +147,28 @@ protected:
 	static void _bind_methods();
 
 private:
-	std::unique_ptr<SBX::LuauRuntime> runtime;
+	std::unique_ptr<SBX::Watchdog> watchdog;
+	// Runs the parallel phases of VMs and actors concurrently
+	std::unique_ptr<SBX::ThreadPool> threadPool;
+	// Keeps runtimes and DataModels ready for restart_runtime
+	std::unique_ptr<SBX::RuntimePool> runtimePool;
+	// Declared before the runtime so it outlives the VMs, which cancel their
+	// tasks on close
+	std::unique_ptr<SBX::TaskScheduler> scheduler;
+	std::unique_ptr<SBX::PooledRuntime> pooled;
+	SBX::LuauRuntime *runtime = nullptr;
 	std::unique_ptr<SBX::Logger> logger;
+	std::unique_ptr<SBX::BytecodeCache> bytecodeCache;
+	SBX::CompileProfile compileProfile = SBX::CompileProfile::Release;
 	std::shared_ptr<SBX::Classes::DataModel> dataModel;
 	bool initialized = false;
-	double elapsedTime = 0.0;
 	bool isServer = true;
 	bool isClient = false;
 
 	static SbxRuntime *singleton;
 
 	void initialize_runtime();
+	void attach_runtime();
 	void setup_data_model();
 };
 
@@ -15,8 +15,11 @@
 #include "SbxGD/SbxRuntime.hpp"
 #include "SbxGD/SbxPart.hpp"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
+#include "godot_cpp/classes/os.hpp"
 #include "godot_cpp/variant/utility_functions.hpp"
 #include "godot_cpp/variant/vector3.hpp"
 #include "godot_cpp/variant/dictionary.hpp"
@@ -26,6 +29,7 @@
 #include "lua.h"
 #include "lualib.h"
 
+#include "Sbx/Classes/ClassDB.hpp"
 #include "Sbx/Classes/DataModel.hpp"
 #include "Sbx/Classes/Humanoid.hpp"
 #include "Sbx/Classes/Model.hpp"
@@ -39,14 +43,26 @@
 #include "Sbx/Classes/Workspace.hpp"
 #include "Sbx/DataTypes/Color3.hpp"
 #include "Sbx/GodotBridge.hpp"
+#include "Sbx/RuntimePool.hpp"
 #include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/BytecodeCache.hpp"
+#include "Sbx/Runtime/CompileOptions.hpp"
 #include "Sbx/Runtime/LuauRuntime.hpp"
 #include "Sbx/Runtime/Logger.hpp"
 #include "Sbx/Runtime/SignalEmitter.hpp"
 #include "Sbx/Runtime/Stack.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
+#include "Sbx/Runtime/ThreadPool.hpp"
+#include "Sbx/Runtime/Watchdog.hpp"
 
 namespace SbxGD {
 
+// Frame time (s) for scripts and GC together. GC gets at least its own
+// budget, plus whatever scripts leave of this.
+#define SCRIPT_FRAME_BUDGET 0.004
+// Runtimes kept ready for restart_runtime
+#define RUNTIME_POOL_SIZE 1
+
 // Singleton instance
 SbxRuntime *SbxRuntime::singleton = nullptr;
 
@@ -54,9 +70,6 @@ static void runtime_init_callback(lua_State *L) {
 	SBX::Bridge::RegisterAllClasses(L);
 }
 
-// GC step sizes for each VM type
-static uint32_t gc_step_sizes[SBX::VMMax] = { 200, 200 };
-
 SbxRuntime::SbxRuntime() {
 	if (singleton == nullptr) {
 		singleton = this;
@@ -98,9 +111,18 @@ void SbxRuntime::_exit_tree() {
 
 	// Destroy the Luau runtime first
 	godot::UtilityFunctions::print("[SbxRuntime] Resetting runtime...");
-	runtime.reset();
+	pooled.reset();
+	runtime = nullptr;
+	runtimePool.reset();
 	godot::UtilityFunctions::print("[SbxRuntime] runtime reset complete");
 
+	// Shared state is unfrozen as the pool's thread stops
+	initialized = false;
+
+	// Pending tasks are cancelled as the VMs close, so this must come after
+	scheduler.reset();
+	threadPool.reset();
+
 	// Now safe to clear the DataModel - signal emission is disabled
 	godot::UtilityFunctions::print("[SbxRuntime] Resetting dataModel...");
 	dataModel.reset();
@@ -119,13 +141,18 @@ void SbxRuntime::_exit_tree() {
 
 void SbxRuntime::_process(double delta) {
 	if (runtime) {
-		// Step the garbage collector each frame
-		runtime->GCStep(gc_step_sizes, delta);
+		double frameStart = lua_clock();
+
+		// Fire RunService signals, resuming scripts at each resumption point
+		auto runService = get_run_service();
+		if (runService) {
+			runService->StepFrame(delta);
+		}
 
-		// Fire RunService signals
-		elapsedTime += delta;
-		fire_stepped(elapsedTime, delta);
-		fire_heartbeat(delta);
+		// Step the garbage collector once scripts are done for the frame,
+		// giving it whatever they left of the script budget
+		double spareTime = SCRIPT_FRAME_BUDGET - (lua_clock() - frameStart);
+		scheduler->GCStep(delta, spareTime);
 	}
 }
 
@@ -137,23 +164,84 @@ void SbxRuntime::initialize_runtime() {
 	// Initialize shadowblox classes via bridge
 	SBX::Bridge::InitializeAllClasses();
 
-	// Create the Luau runtime
-	runtime = std::make_unique<SBX::LuauRuntime>(runtime_init_callback);
+	// Timeout checks only read the watchdog's tick, so they stay enabled
+	watchdog = std::make_unique<SBX::Watchdog>();
+
+	// Create the Luau runtime, serving both VMs from slab allocators, with
+	// script timeouts. Further runtimes are prepared in the background.
+	// The first runtime is created on this thread, initializing the class
+	// metatables and their atoms. They are frozen before the pool's thread
+	// starts, since runtimes are created there from now on.
+	runtimePool = std::make_unique<SBX::RuntimePool>(RUNTIME_POOL_SIZE, runtime_init_callback, true, true, true);
+
+	pooled = runtimePool->Acquire();
+	runtime = pooled->runtime.get();
+
+	// Scripts are often rerun (e.g. for every match), so keep their bytecode
+	// across runs
+	std::string cacheDir = (godot::OS::get_singleton()->get_user_data_dir() + "/bytecode_cache").utf8().get_data();
+	bytecodeCache = std::make_unique<SBX::BytecodeCache>(cacheDir);
 
 	// Create logger for print/warn to work in Luau scripts
 	logger = std::make_unique<SBX::Logger>();
 
-	// Set the logger in both VMs' thread data
+	// Create scheduler for task library and signal waits
+	scheduler = std::make_unique<SBX::TaskScheduler>(runtime);
+
+	// The calling thread runs one VM's parallel phase itself
+	int numWorkers = std::max(static_cast<int>(std::thread::hardware_concurrency()), SBX::VMMax) - 1;
+	threadPool = std::make_unique<SBX::ThreadPool>(numWorkers);
+	scheduler->SetThreadPool(threadPool.get());
+
+	attach_runtime();
+
+	initialized = true;
+	godot::UtilityFunctions::print("[SbxRuntime] Luau runtime initialized");
+}
+
+void SbxRuntime::attach_runtime() {
+	// Set the logger and scheduler in both VMs' thread data. Actors created
+	// later take them from the user VM.
 	for (int i = 0; i < SBX::VMMax; i++) {
 		lua_State *L = runtime->GetVM(SBX::VMType(i));
 		SBX::SbxThreadData *udata = SBX::luaSBX_getthreaddata(L);
 		if (udata && udata->global) {
 			udata->global->logger = logger.get();
+			udata->global->scheduler = scheduler.get();
 		}
 	}
+}
 
-	initialized = true;
-	godot::UtilityFunctions::print("[SbxRuntime] Luau runtime initialized");
+void SbxRuntime::restart_runtime() {
+	if (!runtime) {
+		return;
+	}
+
+	// Native code settings are kept in the VMs
+	SBX::SbxGlobalThreadData *global = SBX::luaSBX_getthreaddata(runtime->GetVM(SBX::UserVM))->global;
+	SBX::NativeCodeMode nativeMode = global->nativeMode;
+	double nativeHotThreshold = global->nativeHotThreshold;
+
+	// Stops RunService and cancels pending tasks; the VMs are closed in the
+	// background
+	dataModel.reset();
+	runtime = nullptr;
+	runtimePool->Release(std::move(pooled));
+
+	pooled = runtimePool->Acquire();
+	runtime = pooled->runtime.get();
+	scheduler->SetRuntime(runtime);
+
+	attach_runtime();
+
+	for (int i = 0; i < SBX::VMMax; i++) {
+		global = SBX::luaSBX_getthreaddata(runtime->GetVM(SBX::VMType(i)))->global;
+		global->nativeMode = nativeMode;
+		global->nativeHotThreshold = nativeHotThreshold;
+	}
+
+	setup_data_model();
+	godot::UtilityFunctions::print("[SbxRuntime] Luau runtime restarted");
 }
 
 // Luau callback: setPlayerColor(userId, color)
@@ -183,25 +271,32 @@ static int luaSbx_setStatusText(lua_State *L) {
 	return 0;
 }
 
-void SbxRuntime::setup_data_model() {
-	if (!runtime) return;
-
-	// Create DataModel (the 'game' object)
-	dataModel = SBX::Bridge::CreateDataModel();
-
-	// Get the VM and register globals
-	lua_State *L = runtime->GetVM(SBX::UserVM);
-	SBX::Bridge::RegisterGlobals(L, dataModel);
-
+static void register_callbacks(lua_State *L) {
 	// Register Luau-to-GDScript callback functions
 	lua_pushcfunction(L, luaSbx_setPlayerColor, "setPlayerColor");
 	lua_setglobal(L, "setPlayerColor");
 
 	lua_pushcfunction(L, luaSbx_setStatusText, "setStatusText");
 	lua_setglobal(L, "setStatusText");
+}
 
-	// Start RunService so Heartbeat/Stepped signals fire
+void SbxRuntime::setup_data_model() {
+	if (!runtime) return;
+
+	// The DataModel (the 'game' object) comes with the runtime, with globals
+	// already registered
+	dataModel = pooled->dataModel;
+	lua_State *L = runtime->GetVM(SBX::UserVM);
+
+	// RunService drives the scheduler through the frame
 	auto runService = get_run_service();
+	if (runService) {
+		runService->SetScheduler(scheduler.get());
+	}
+
+	register_callbacks(L);
+
+	// Start RunService so Heartbeat/Stepped signals fire
 	if (runService) {
 		runService->Run();
 	}
@@ -224,18 +319,22 @@ std::shared_ptr<SBX::Classes::RunService> SbxRuntime::get_run_service() const {
 	return dataModel->GetRunService();
 }
 
-godot::String SbxRuntime::execute_script(const godot::String &code) {
+godot::String SbxRuntime::execute_script(const godot::String &code, int actor) {
 	if (!runtime) {
 		return "Error: Runtime not initialized";
 	}
 
-	lua_State *L = runtime->GetVM(SBX::UserVM);
+	if (actor >= static_cast<int>(runtime->NumActors())) {
+		return "Error: Invalid actor";
+	}
+
+	lua_State *L = actor >= 0 ? runtime->GetActor(actor) : runtime->GetVM(SBX::UserVM);
 	lua_State *T = lua_newthread(L);
 	luaL_sandboxthread(T);
 
 	// Compile the script
-	Luau::CompileOptions opts;
-	std::string bytecode = Luau::compile(code.utf8().get_data(), opts);
+	const Luau::CompileOptions &opts = SBX::luaSBX_compileoptions(compileProfile);
+	std::string bytecode = bytecodeCache->Compile(code.utf8().get_data(), opts, SBX::luaSBX_compileprofilename(compileProfile));
 
 	// Load and execute
 	if (luau_load(T, "=script", bytecode.data(), bytecode.size(), 0) != 0) {
@@ -244,6 +343,9 @@ godot::String SbxRuntime::execute_script(const godot::String &code) {
 		return godot::String("Compile Error: ") + godot::String(error.c_str());
 	}
 
+	// Native code, if annotated or forced by set_native_mode
+	SBX::luaSBX_loadnative(T, -1, nullptr);
+
 	int status = SBX::luaSBX_resume(T, nullptr, 0, 1.0);
 
 	if (status != LUA_OK && status != LUA_YIELD) {
@@ -255,6 +357,18 @@ godot::String SbxRuntime::execute_script(const godot::String &code) {
 	return "OK";
 }
 
+int SbxRuntime::create_actor() {
+	if (!runtime) {
+		return -1;
+	}
+
+	lua_State *L = runtime->CreateActor();
+	SBX::Bridge::RegisterGlobals(L, dataModel);
+	register_callbacks(L);
+
+	return static_cast<int>(runtime->NumActors()) - 1;
+}
+
 godot::String SbxRuntime::run_script(const godot::String &code, SbxPart *script_parent) {
 	if (!runtime) {
 		return "Error: Runtime not initialized";
@@ -277,9 +391,12 @@ godot::String SbxRuntime::run_script(const godot::String &code, SbxPart *script_
 	// Register 'script' global in this thread
 	SBX::Bridge::RegisterScriptGlobal(T, script);
 
+	// Charge this thread and any it creates to the script
+	SBX::luaSBX_setcpuusage(T, script->GetCpuUsage());
+
 	// Compile the script
-	Luau::CompileOptions opts;
-	std::string bytecode = Luau::compile(code.utf8().get_data(), opts);
+	const Luau::CompileOptions &opts = SBX::luaSBX_compileoptions(compileProfile);
+	std::string bytecode = bytecodeCache->Compile(code.utf8().get_data(), opts, SBX::luaSBX_compileprofilename(compileProfile));
 
 	// Load and execute
 	if (luau_load(T, "=script", bytecode.data(), bytecode.size(), 0) != 0) {
@@ -288,6 +405,9 @@ godot::String SbxRuntime::run_script(const godot::String &code, SbxPart *script_
 		return godot::String("Compile Error: ") + godot::String(error.c_str());
 	}
 
+	// Native code, if annotated or forced by set_native_mode, or once hot
+	SBX::luaSBX_loadnative(T, -1, script->GetCpuUsage().get());
+
 	int status = SBX::luaSBX_resume(T, nullptr, 0, 1.0);
 
 	if (status != LUA_OK && status != LUA_YIELD) {
@@ -323,8 +443,9 @@ void SbxRuntime::fire_stepped(double time, double delta) {
 
 void SbxRuntime::gc_step(int step_size) {
 	if (runtime) {
-		uint32_t steps[SBX::VMMax] = { static_cast<uint32_t>(step_size), static_cast<uint32_t>(step_size) };
-		runtime->GCStep(steps, 0.0);
+		for (int i = 0; i < SBX::VMMax; i++) {
+			runtime->GCStep(SBX::VMType(i), static_cast<uint32_t>(step_size));
+		}
 	}
 }
 
@@ -338,6 +459,76 @@ int SbxRuntime::get_gc_memory() const {
 	return static_cast<int>(memory[0] + memory[1]);
 }
 
+godot::Dictionary SbxRuntime::get_bytecode_cache_stats() const {
+	godot::Dictionary result;
+	if (!bytecodeCache) {
+		return result;
+	}
+
+	SBX::BytecodeCacheStats stats = bytecodeCache->GetStats();
+	result["hits"] = static_cast<int64_t>(stats.hits);
+	result["disk_hits"] = static_cast<int64_t>(stats.diskHits);
+	result["misses"] = static_cast<int64_t>(stats.misses);
+	result["entries"] = static_cast<int64_t>(bytecodeCache->Size());
+	return result;
+}
+
+void SbxRuntime::set_compile_profile(int profile) {
+	if (profile < 0 || profile > static_cast<int>(SBX::CompileProfile::Release)) {
+		return;
+	}
+
+	compileProfile = static_cast<SBX::CompileProfile>(profile);
+}
+
+void SbxRuntime::set_native_mode(int mode, double hot_threshold) {
+	if (!runtime || mode < 0 || mode > static_cast<int>(SBX::NativeCodeMode::All)) {
+		return;
+	}
+
+	auto setNativeMode = [&](lua_State *L) {
+		SBX::SbxGlobalThreadData *global = SBX::luaSBX_getthreaddata(L)->global;
+		global->nativeMode = static_cast<SBX::NativeCodeMode>(mode);
+		global->nativeHotThreshold = hot_threshold;
+	};
+
+	for (int i = 0; i < SBX::VMMax; i++) {
+		setNativeMode(runtime->GetVM(SBX::VMType(i)));
+	}
+
+	for (size_t i = 0; i < runtime->NumActors(); i++) {
+		setNativeMode(runtime->GetActor(i));
+	}
+}
+
+godot::Dictionary SbxRuntime::get_native_stats() const {
+	godot::Dictionary result;
+	if (!runtime) {
+		return result;
+	}
+
+	SBX::SbxNativeStats total;
+	auto addStats = [&](lua_State *L) {
+		const SBX::SbxNativeStats &stats = SBX::luaSBX_getthreaddata(L)->global->nativeStats;
+		total.functionsCompiled += stats.functionsCompiled;
+		total.bytesCompiled += stats.bytesCompiled;
+		total.hotScripts += stats.hotScripts;
+	};
+
+	for (int i = 0; i < SBX::VMMax; i++) {
+		addStats(runtime->GetVM(SBX::VMType(i)));
+	}
+
+	for (size_t i = 0; i < runtime->NumActors(); i++) {
+		addStats(runtime->GetActor(i));
+	}
+
+	result["functions_compiled"] = static_cast<int64_t>(total.functionsCompiled);
+	result["bytes_compiled"] = static_cast<int64_t>(total.bytesCompiled);
+	result["hot_scripts"] = static_cast<int64_t>(total.hotScripts);
+	return result;
+}
+
 void SbxRuntime::set_is_server(bool is_server) {
 	isServer = is_server;
 	auto runService = get_run_service();
@@ -595,9 +786,16 @@ void SbxRuntime::set_status_text(const godot::String &text) {
 }
 
 void SbxRuntime::_bind_methods() {
-	godot::ClassDB::bind_method(godot::D_METHOD("execute_script", "code"), &SbxRuntime::execute_script);
+	godot::ClassDB::bind_method(godot::D_METHOD("restart_runtime"), &SbxRuntime::restart_runtime);
+	godot::ClassDB::bind_method(godot::D_METHOD("execute_script", "code", "actor"), &SbxRuntime::execute_script, DEFVAL(-1));
+	godot::ClassDB::bind_method(godot::D_METHOD("create_actor"), &SbxRuntime::create_actor);
 	godot::ClassDB::bind_method(godot::D_METHOD("gc_step", "step_size"), &SbxRuntime::gc_step);
 	godot::ClassDB::bind_method(godot::D_METHOD("get_gc_memory"), &SbxRuntime::get_gc_memory);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_bytecode_cache_stats"), &SbxRuntime::get_bytecode_cache_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_compile_profile", "profile"), &SbxRuntime::set_compile_profile);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_compile_profile"), &SbxRuntime::get_compile_profile);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_native_mode", "mode", "hot_threshold"), &SbxRuntime::set_native_mode, DEFVAL(0.05));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_native_stats"), &SbxRuntime::get_native_stats);
 	godot::ClassDB::bind_method(godot::D_METHOD("create_local_player", "user_id", "display_name"), &SbxRuntime::create_local_player);
 	godot::ClassDB::bind_method(godot::D_METHOD("fire_heartbeat", "delta"), &SbxRuntime::fire_heartbeat);
 	godot::ClassDB::bind_method(godot::D_METHOD("fire_stepped", "time", "delta"), &SbxRuntime::fire_stepped);
@@ -26,6 +26,7 @@
 #include "Sbx/DataTypes/Types.hpp"
 #include "Sbx/Runtime/Base.hpp"
 #include "Sbx/Runtime/SignalEmitter.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
 #include "Utils.hpp"
 
 using namespace SBX;
@@ -94,6 +95,11 @@ TEST_CASE("properties") {
 		CHECK_EQ(std::string(inst->GetName()), "TestPart");
 	}
 
+	SUBCASE("Name set to null") {
+		CHECK(inst->Set<const char *>("Name", nullptr));
+		CHECK_EQ(std::string(inst->GetName()), "");
+	}
+
 	SUBCASE("Parent default") {
 		CHECK_EQ(inst->GetParent(), nullptr);
 	}
@@ -521,6 +527,45 @@ TEST_CASE("Luau API") {
 		CHECK_EVAL_EQ(L, "return parent:IsA('Object')", bool, true);
 	}
 
+	SUBCASE("parallel") {
+		udata->desynchronized = true;
+
+		CHECK_EVAL_OK(L, "assert(#parent:GetChildren() == 1)");
+		CHECK_EVAL_FAIL(L, "return parent.Name", "exec:1: TestInstance.Name is not safe to read in parallel");
+		CHECK_EVAL_FAIL(L, "parent.Name = 'NewName'", "exec:1: TestInstance.Name is not safe to write in parallel");
+		CHECK_EQ(std::string(parent->GetName()), "Parent");
+
+		// Custom Luau accessors
+		CHECK_EVAL_OK(L, "assert(child.Parent == parent)");
+		CHECK_EVAL_FAIL(L, "child.Parent = nil", "exec:1: TestInstance.Parent is not safe to write in parallel");
+		CHECK_EQ(child->GetParent(), parent);
+
+		udata->desynchronized = false;
+	}
+
+	SUBCASE("desynchronize") {
+		TaskScheduler scheduler(nullptr);
+		udata->global->scheduler = &scheduler;
+
+		CHECK_EVAL_OK(L, R"ASDF(
+			task.spawn(function()
+				task.desynchronize()
+				readOk = pcall(function() return child.Parent end)
+				writeOk, writeErr = pcall(function() child.Parent = nil end)
+			end)
+		)ASDF");
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+
+		CHECK_EVAL_OK(L, "assert(readOk)");
+		CHECK_EVAL_OK(L, "assert(not writeOk)");
+		CHECK_EVAL_OK(L, "assert(string.find(writeErr, 'TestInstance.Parent is not safe to write in parallel', 1, true))");
+		CHECK_EQ(child->GetParent(), parent);
+
+		udata->global->scheduler = nullptr;
+	}
+
 	luaSBX_close(L);
 }
 
@@ -544,6 +589,24 @@ TEST_CASE("signals") {
 	LuauStackOp<std::shared_ptr<TestInstance>>::Push(L, child);
 	lua_setglobal(L, "child");
 
+	SUBCASE("no listeners") {
+		// Emitting and property changes do nothing until a signal is pushed
+		child->SetParent(parent);
+		child->SetName("Child");
+		CHECK_FALSE(parent->HasSignalEmitter());
+		CHECK_FALSE(child->HasSignalEmitter());
+
+		CHECK_EVAL_OK(L, "assert(child.Name == 'Child')");
+		CHECK_FALSE(child->HasSignalEmitter());
+
+		CHECK_EVAL_OK(L, "local _ = child.Changed");
+		CHECK(child->HasSignalEmitter());
+		CHECK_FALSE(parent->HasSignalEmitter());
+
+		child->SetName("Other");
+		child->SetParent(nullptr);
+	}
+
 	SUBCASE("ChildAdded signal") {
 		CHECK_EVAL_OK(L, R"(
 			addedChild = nil
@@ -69,7 +69,7 @@ public:
 			luaSBX_pcall(T, 2, 0, 0);
 		}
 
-		Emit<TestDerived>("TestSignal", arg1, arg2);
+		Emit<TestDerived, "TestSignal">(arg1, arg2);
 		return arg2;
 	}
 
@@ -146,6 +146,19 @@ TEST_CASE("runtime type information") {
 		CHECK_EQ(info->tags, std::unordered_set<ClassTag>{ ClassTag::NotReplicated });
 	}
 
+	SUBCASE("class IDs") {
+		CHECK_GE(Object::CLASS_ID, 0);
+		CHECK_GE(TestDerived::CLASS_ID, 0);
+		CHECK_EQ(ClassDB::GetClassId("TestDerived"), TestDerived::CLASS_ID);
+		CHECK_EQ(ClassDB::GetClassId("aoihdoigahsoidhgoiasdag"), -1);
+
+		CHECK(ClassDB::IsA(TestDerived::CLASS_ID, Object::CLASS_ID));
+		CHECK(ClassDB::IsA(TestDerived::CLASS_ID, TestDerived::CLASS_ID));
+		CHECK_FALSE(ClassDB::IsA(Object::CLASS_ID, TestDerived::CLASS_ID));
+		CHECK_FALSE(ClassDB::IsA(TestDerived::CLASS_ID, -1));
+		CHECK_FALSE(ClassDB::IsA("Vector3", "Object"));
+	}
+
 	SUBCASE("method") {
 		const ClassDB::Function *func = ClassDB::GetFunction("TestDerived", "TestMethod");
 		REQUIRE_NE(func, nullptr);
@@ -340,6 +353,11 @@ TEST_CASE("stack operation") {
 
 	LuauStackOp<Ref>::Push(L, testDerived);
 	CHECK_EQ(testDerived.use_count(), 2);
+	CHECK_EQ(lua_userdatatag(L, -1), ObjectUdata);
+	CHECK(LuauStackOp<Ref>::Is(L, -1));
+	CHECK(LuauStackOp<std::shared_ptr<Object>>::Is(L, -1));
+	CHECK_EQ(LuauStackOp<Ref>::Get(L, -1), testDerived);
+	CHECK_EQ(LuauStackOp<TestDerived *>::Get(L, -1), testDerived.get());
 
 	// Registry use; generic object stack operator
 	LuauStackOp<std::shared_ptr<Object>>::Push(L, testDerived);
@@ -351,6 +369,15 @@ TEST_CASE("stack operation") {
 	lua_gc(L, LUA_GCCOLLECT, 0);
 	CHECK_EQ(testDerived.use_count(), 1);
 
+	// Cached userdata after collection
+	LuauStackOp<Ref>::Push(L, testDerived);
+	LuauStackOp<Ref>::Push(L, testDerived);
+	CHECK(lua_rawequal(L, -2, -1));
+	CHECK_EQ(testDerived.use_count(), 2);
+	lua_pop(L, 2);
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	CHECK_EQ(testDerived.use_count(), 1);
+
 	// Null
 	LuauStackOp<std::shared_ptr<Object>>::Push(L, std::shared_ptr<Object>());
 	CHECK(lua_isnil(L, -1));
@@ -411,6 +438,20 @@ TEST_CASE("Luau API") {
 		CHECK_EVAL_FAIL(L, "inst.Behavior = 0", "exec:1: Behavior is not a valid member of TestDerived");
 	}
 
+	SUBCASE("callback read") {
+		CHECK_EVAL_FAIL(L, "return inst.TestCallback", "exec:1: TestCallback is a callback member of TestDerived; you can only set the callback value, get is not available");
+	}
+
+	SUBCASE("signal write") {
+		CHECK_EVAL_FAIL(L, "inst.TestSignal = 0", "exec:1: TestSignal is not a valid member of TestDerived");
+	}
+
+	SUBCASE("signal caching") {
+		CHECK_EVAL_EQ(L, "return rawequal(inst.Changed, inst.Changed)", bool, true);
+		CHECK_EVAL_EQ(L, "return rawequal(inst.StrChanged, inst:GetPropertyChangedSignal('Str'))", bool, true);
+		CHECK_EVAL_EQ(L, "return rawequal(inst.Changed, inst.StrChanged)", bool, false);
+	}
+
 	SUBCASE("property signals") {
 		SUBCASE("working") {
 			CHECK_EVAL_OK(L, R"ASDF(
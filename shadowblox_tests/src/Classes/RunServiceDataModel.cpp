@@ -31,6 +31,7 @@
 #include "Sbx/DataTypes/Vector3.hpp"
 #include "Sbx/GodotBridge.hpp"
 #include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
 #include "Utils.hpp"
 
 using namespace SBX;
@@ -482,6 +483,35 @@ TEST_CASE("RunService Luau API") {
 	luaSBX_close(L);
 }
 
+TEST_CASE("RunService frame pipeline") {
+	InitClasses();
+
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+	luaSBX_getthreaddata(L)->global->scheduler = &scheduler;
+
+	auto rs = MakeRunService();
+	rs->SetScheduler(&scheduler);
+	rs->Run();
+
+	CHECK_EVAL_OK(L, "task.wait(1)");
+	REQUIRE_EQ(lua_status(L), LUA_YIELD);
+
+	// The clock advances once per frame despite several resumption points
+	rs->StepFrame(0.6);
+	CHECK_EQ(scheduler.GetTime(), 0.6);
+	CHECK_EQ(lua_status(L), LUA_YIELD);
+
+	rs->StepFrame(0.6);
+	CHECK_EQ(lua_status(L), LUA_OK);
+
+	// Individual signals are treated as separate frames
+	rs->FireHeartbeat(0.5);
+	CHECK_EQ(scheduler.GetTime(), doctest::Approx(1.7));
+
+	luaSBX_close(L);
+}
+
 TEST_CASE("game/workspace relationship") {
 	InitClasses();
 
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lua.h"
+
+#include "Sbx/Classes/ClassDB.hpp"
+#include "Sbx/Classes/DataModel.hpp"
+#include "Sbx/Classes/RunService.hpp"
+#include "Sbx/MatchHost.hpp"
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/LuauRuntime.hpp"
+#include "Utils.hpp"
+
+using namespace SBX;
+
+TEST_SUITE_BEGIN("MatchHost");
+
+static void CheckTicks(lua_State *L, double expected) {
+	EVAL_THEN(L, "return _G.ticks", {
+		CHECK_EQ(lua_tonumber(L, -1), expected);
+	});
+}
+
+TEST_CASE("match host") {
+	MatchHost host(2, 1);
+
+	MatchId a = host.CreateMatch(32.0);
+	MatchId b = host.CreateMatch(16.0);
+	MatchId c = host.CreateMatch(0.0);
+	REQUIRE_EQ(host.NumMatches(), 3u);
+
+	lua_State *LA = host.GetRuntime(a)->GetVM(UserVM);
+	lua_State *LB = host.GetRuntime(b)->GetVM(UserVM);
+	lua_State *LC = host.GetRuntime(c)->GetVM(UserVM);
+
+	for (lua_State *L : { LA, LB, LC }) {
+		CHECK_EVAL_OK(L, "_G.ticks = 0; game:GetService('RunService').Heartbeat:Connect(function() _G.ticks += 1 end)");
+	}
+
+	SUBCASE("isolated") {
+		CHECK_NE(host.GetDataModel(a), host.GetDataModel(b));
+		CHECK_NE(LA, LB);
+
+		CHECK_EVAL_OK(LA, "_G.value = 'a'");
+		CHECK_EVAL_OK(LB, "assert(_G.value == nil)");
+	}
+
+	SUBCASE("tick rates") {
+		// Ticks are due at each match's own rate
+		for (int i = 0; i < 10; i++) {
+			host.Step(1.0 / 16.0);
+		}
+
+		CheckTicks(LA, 20.0);
+		CheckTicks(LB, 10.0);
+		CheckTicks(LC, 10.0);
+	}
+
+	SUBCASE("catch-up limit") {
+		host.Step(1.0);
+
+		CheckTicks(LA, 4.0);
+		CheckTicks(LB, 4.0);
+		CheckTicks(LC, 1.0);
+	}
+
+	SUBCASE("network callbacks") {
+		std::vector<std::string> sent;
+		host.SetNetworkCallbacks(a, [&sent](const char *eventName, int64_t /*targetId*/, const std::vector<uint8_t> & /*data*/) { sent.emplace_back(eventName); }, nullptr);
+
+		const char *fire = "local e = Instance.new('RemoteEvent'); e.Name = 'Ping'; e:FireAllClients(1)";
+		CHECK_EVAL_OK(LA, fire);
+		CHECK_EVAL_OK(LB, fire);
+
+		REQUIRE_EQ(sent.size(), 1u);
+		CHECK_EQ(sent[0], "Ping");
+	}
+
+	SUBCASE("destroy") {
+		host.DestroyMatch(b);
+		CHECK_FALSE(host.HasMatch(b));
+		CHECK_EQ(host.GetRuntime(b), nullptr);
+		CHECK_EQ(host.NumMatches(), 2u);
+
+		host.Step(1.0 / 16.0);
+		CheckTicks(LA, 2.0);
+		CheckTicks(LC, 1.0);
+	}
+}
+
+TEST_CASE("teardown") {
+	std::shared_ptr<Classes::RunService> runService;
+
+	{
+		MatchHost host(1, 1);
+		CHECK(Classes::ClassDB::IsFrozen());
+
+		MatchId id = host.CreateMatch();
+		CHECK_EVAL_OK(host.GetRuntime(id)->GetVM(UserVM), "game:GetService('RunService').Heartbeat:Connect(function() end)");
+
+		runService = host.GetDataModel(id)->GetRunService();
+		CHECK_EQ(runService->NumConnections(), 1);
+	}
+
+	// Outlives the match's VMs, so must not keep references into them
+	CHECK_EQ(runService->NumConnections(), 0);
+
+	// Other tests register classes later
+	CHECK_FALSE(Classes::ClassDB::IsFrozen());
+}
+
+TEST_SUITE_END();
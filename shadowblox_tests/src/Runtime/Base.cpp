@@ -14,9 +14,16 @@
 
 #include "doctest.h"
 
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "Luau/CodeGen.h"
+#include "Luau/Compiler.h"
 #include "lua.h"
 
 #include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/Watchdog.hpp"
 #include "Utils.hpp"
 
 using namespace SBX;
@@ -133,12 +140,137 @@ TEST_CASE("registry") {
 	luaSBX_close(L);
 }
 
+TEST_CASE("atoms") {
+	int16_t atom = luaSBX_addatom("SbxTestAtom");
+	REQUIRE_GE(atom, 0);
+	CHECK_EQ(luaSBX_addatom("SbxTestAtom"), atom);
+	CHECK_EQ(luaSBX_findatom("SbxTestAtom", 11), atom);
+	CHECK_EQ(luaSBX_findatom("SbxTestAtom2", 12), -1);
+
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+
+	int strAtom = -1;
+	lua_pushstring(L, "SbxTestAtom");
+	lua_tostringatom(L, -1, &strAtom);
+	CHECK_EQ(strAtom, atom);
+	lua_pop(L, 1);
+
+	luaSBX_close(L);
+}
+
 TEST_CASE("timeout") {
 	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
 	luaSBX_debugcallbacks(L);
 
 	CHECK_EVAL_FAIL(L, "while true do end", "Script timed out: exhausted allowed execution time");
 
+	SUBCASE("watchdog") {
+		Watchdog watchdog;
+		CHECK_EVAL_FAIL(L, "while true do end", "Script timed out: exhausted allowed execution time");
+	}
+
+	SUBCASE("disabled") {
+		std::string bytecode = Luau::compile("local x = 0 for i = 1, 100000 do x += i end");
+		REQUIRE_EQ(luau_load(L, "=test", bytecode.data(), bytecode.size(), 0), 0);
+
+		CHECK_EQ(luaSBX_pcall(L, 0, 0, 0, 0.0), LUA_OK);
+		CHECK_EQ(luaSBX_getthreaddata(L)->interruptDeadline, 0u);
+	}
+
+	luaSBX_close(L);
+}
+
+TEST_CASE("accounting") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	Watchdog watchdog;
+
+	// Charged in whole watchdog ticks
+	CHECK_EVAL_OK(L, "local x = 0 for i = 1, 100000 do x += i end");
+	double cpuTime = luaSBX_getthreaddata(L)->cpuTime;
+	CHECK_GE(cpuTime, 0.0);
+	CHECK_EQ(cpuTime * 1e3, doctest::Approx(std::round(cpuTime * 1e3)));
+
+	luaSBX_close(L);
+}
+
+TEST_CASE("native code") {
+	if (!Luau::CodeGen::isSupported()) {
+		return;
+	}
+
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	SbxGlobalThreadData *global = luaSBX_getthreaddata(L)->global;
+	SbxCpuUsage usage;
+
+	auto load = [&](const char *src) {
+		std::string bytecode = Luau::compile(src);
+		REQUIRE_EQ(luau_load(L, "=native", bytecode.data(), bytecode.size(), 0), 0);
+	};
+
+	const char *loop = "local n = 0; for i = 1, 10 do n += i end; return n";
+
+	SUBCASE("annotated") {
+		load(loop);
+		CHECK_FALSE(luaSBX_loadnative(L, -1, nullptr));
+
+		load((std::string("--!native\n") + loop).c_str());
+		CHECK(luaSBX_loadnative(L, -1, nullptr));
+		CHECK_GT(global->nativeStats.functionsCompiled, 0);
+		CHECK_GT(global->nativeStats.bytesCompiled, 0);
+	}
+
+	SUBCASE("all") {
+		global->nativeMode = NativeCodeMode::All;
+		load(loop);
+		CHECK(luaSBX_loadnative(L, -1, nullptr));
+	}
+
+	SUBCASE("disabled") {
+		global->nativeMode = NativeCodeMode::Disabled;
+		load((std::string("--!native\n") + loop).c_str());
+		CHECK_FALSE(luaSBX_loadnative(L, -1, nullptr));
+	}
+
+	SUBCASE("hot") {
+		global->nativeHotThreshold = 1e-9;
+
+		load(loop);
+		CHECK_FALSE(luaSBX_loadnative(L, -1, &usage));
+		CHECK_NE(usage.nativeRef, LUA_NOREF);
+
+		// Compiled after running past the threshold
+		lua_State *T = lua_newthread(L);
+		luaSBX_setcpuusage(T, std::shared_ptr<SbxCpuUsage>(&usage, [](SbxCpuUsage *) {}));
+		lua_pushvalue(L, -2);
+		lua_xmove(L, T, 1);
+		CHECK_EQ(luaSBX_resume(T, nullptr, 0), LUA_OK);
+
+		CHECK_EQ(usage.nativeRef, LUA_NOREF);
+		CHECK_EQ(global->nativeStats.hotScripts, 1);
+	}
+
+	SUBCASE("stopped") {
+		global->nativeHotThreshold = 1e9;
+
+		lua_State *T = lua_newthread(L);
+		luaSBX_setcpuusage(T, std::shared_ptr<SbxCpuUsage>(&usage, [](SbxCpuUsage *) {}));
+		CHECK_EQ(usage.numThreads, 1);
+
+		load(loop);
+		lua_xmove(L, T, 1);
+		CHECK_FALSE(luaSBX_loadnative(T, -1, &usage));
+		CHECK_EQ(luaSBX_resume(T, nullptr, 0), LUA_OK);
+
+		// Held while the script may still run
+		CHECK_NE(usage.nativeRef, LUA_NOREF);
+
+		lua_pop(L, 1); // thread
+		lua_gc(L, LUA_GCCOLLECT, 0);
+
+		CHECK_EQ(usage.numThreads, 0);
+		CHECK_EQ(usage.nativeRef, LUA_NOREF);
+	}
+
 	luaSBX_close(L);
 }
 
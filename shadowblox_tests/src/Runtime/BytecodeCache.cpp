@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "doctest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Luau/Compiler.h"
+
+#include "Sbx/Runtime/BytecodeCache.hpp"
+#include "Sbx/Runtime/CompileOptions.hpp"
+
+using namespace SBX;
+
+TEST_SUITE_BEGIN("Runtime/BytecodeCache");
+
+TEST_CASE("memory") {
+	BytecodeCache cache;
+	Luau::CompileOptions opts;
+
+	std::string bytecode = cache.Compile("return 1 + 1", opts);
+	CHECK_EQ(bytecode, Luau::compile("return 1 + 1", opts));
+	CHECK_EQ(cache.GetStats().misses, 1);
+
+	CHECK_EQ(cache.Compile("return 1 + 1", opts), bytecode);
+	CHECK_EQ(cache.GetStats().hits, 1);
+
+	SUBCASE("options") {
+		opts.optimizationLevel = 2;
+		cache.Compile("return 1 + 1", opts);
+		CHECK_EQ(cache.GetStats().misses, 2);
+
+		cache.Compile("return 1 + 1", opts, "profile");
+		CHECK_EQ(cache.GetStats().misses, 3);
+		CHECK_EQ(cache.Size(), 3);
+	}
+
+	SUBCASE("clear") {
+		cache.Clear();
+		cache.Compile("return 1 + 1", opts);
+		CHECK_EQ(cache.GetStats().misses, 2);
+	}
+}
+
+TEST_CASE("eviction") {
+	BytecodeCache cache("", 2);
+	Luau::CompileOptions opts;
+
+	cache.Compile("return 1", opts);
+	cache.Compile("return 2", opts);
+	// Touch the first, so the second is least recently used
+	cache.Compile("return 1", opts);
+	cache.Compile("return 3", opts);
+
+	CHECK_EQ(cache.Size(), 2);
+	CHECK_EQ(cache.GetStats().evictions, 1);
+
+	cache.Compile("return 1", opts);
+	CHECK_EQ(cache.GetStats().hits, 2);
+
+	cache.Compile("return 2", opts);
+	CHECK_EQ(cache.GetStats().misses, 4);
+}
+
+TEST_CASE("profiles") {
+	BytecodeCache cache;
+	const char *src = "return math.pi * 2";
+
+	std::string debug = cache.Compile(src, luaSBX_compileoptions(CompileProfile::Debug), luaSBX_compileprofilename(CompileProfile::Debug));
+	std::string release = cache.Compile(src, luaSBX_compileoptions(CompileProfile::Release), luaSBX_compileprofilename(CompileProfile::Release));
+
+	CHECK_NE(debug, release);
+	CHECK_EQ(cache.GetStats().misses, 2);
+}
+
+TEST_CASE("disk") {
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "sbx_bytecode_cache_test";
+	std::filesystem::remove_all(dir);
+
+	Luau::CompileOptions opts;
+	std::string bytecode;
+
+	{
+		BytecodeCache cache(dir.string());
+		bytecode = cache.Compile("return 'persisted'", opts);
+		CHECK_EQ(cache.GetStats().misses, 1);
+	}
+
+	{
+		BytecodeCache cache(dir.string());
+		CHECK_EQ(cache.Compile("return 'persisted'", opts), bytecode);
+		CHECK_EQ(cache.GetStats().misses, 0);
+		CHECK_EQ(cache.GetStats().diskHits, 1);
+	}
+
+	SUBCASE("corrupt") {
+		for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+			// Flip the last byte of the bytecode
+			std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+			file.seekg(-1, std::ios::end);
+			char c = static_cast<char>(file.get());
+			file.seekp(-1, std::ios::end);
+			file.put(static_cast<char>(c ^ 0xff));
+		}
+
+		BytecodeCache cache(dir.string());
+		CHECK_EQ(cache.Compile("return 'persisted'", opts), bytecode);
+		CHECK_EQ(cache.GetStats().misses, 1);
+		CHECK_EQ(cache.GetStats().diskHits, 0);
+	}
+
+	SUBCASE("truncated") {
+		for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+			std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 1);
+		}
+
+		BytecodeCache cache(dir.string());
+		CHECK_EQ(cache.Compile("return 'persisted'", opts), bytecode);
+		CHECK_EQ(cache.GetStats().misses, 1);
+	}
+
+	// No temporary files are left behind
+	for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+		CHECK_EQ(entry.path().extension().string(), ".luauc");
+	}
+
+	std::filesystem::remove_all(dir);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "doctest.h"
+
+#include <cmath>
+#include <numbers>
+#include <string>
+
+#include "Luau/Compiler.h"
+#include "lua.h"
+
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/BytecodeCache.hpp"
+#include "Sbx/Runtime/CompileOptions.hpp"
+
+using namespace SBX;
+
+TEST_SUITE_BEGIN("Runtime/CompileOptions");
+
+static void luaSBX_loadprofile(lua_State *L, BytecodeCache &cache, const char *src, CompileProfile profile) {
+	std::string bytecode = cache.Compile(src, luaSBX_compileoptions(profile), luaSBX_compileprofilename(profile));
+	REQUIRE_EQ(luau_load(L, "=profile", bytecode.data(), bytecode.size(), 0), 0);
+}
+
+TEST_CASE("release") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	BytecodeCache cache;
+
+	SUBCASE("math constants") {
+		luaSBX_loadprofile(L, cache, "return math.pi * 2, math.huge", CompileProfile::Release);
+		REQUIRE_EQ(lua_pcall(L, 0, 2, 0), LUA_OK);
+
+		CHECK_EQ(lua_tonumber(L, -2), std::numbers::pi * 2);
+		CHECK_EQ(lua_tonumber(L, -1), HUGE_VAL);
+		lua_pop(L, 2);
+	}
+
+	SUBCASE("mutable globals") {
+		// Rebound by the host after load, so must not be imported at load time
+		lua_pushnumber(L, 1);
+		lua_setglobal(L, "game");
+
+		luaSBX_loadprofile(L, cache, "return game", CompileProfile::Release);
+
+		lua_pushnumber(L, 2);
+		lua_setglobal(L, "game");
+
+		REQUIRE_EQ(lua_pcall(L, 0, 1, 0), LUA_OK);
+		CHECK_EQ(lua_tonumber(L, -1), 2);
+		lua_pop(L, 1);
+	}
+
+	SUBCASE("cached") {
+		const char *src = "local t = {} for i = 1, 10 do t[i] = i * i end return t[10]";
+
+		for (int i = 0; i < 2; i++) {
+			luaSBX_loadprofile(L, cache, src, CompileProfile::Release);
+			REQUIRE_EQ(lua_pcall(L, 0, 1, 0), LUA_OK);
+			CHECK_EQ(lua_tonumber(L, -1), 100);
+			lua_pop(L, 1);
+		}
+
+		CHECK_EQ(cache.GetStats().misses, 1);
+		CHECK_EQ(cache.GetStats().hits, 1);
+	}
+
+	luaSBX_close(L);
+}
+
+TEST_SUITE_END();
@@ -46,4 +46,44 @@ TEST_CASE("initialize") {
 	CHECK_EQ(udataUser->identity, GameScriptIdentity);
 }
 
+TEST_CASE("actors") {
+	static int hit = 0;
+	LuauRuntime rt([](lua_State *L) {
+		hit++;
+	});
+
+	hit = 0;
+	CHECK_EQ(rt.NumActors(), 0u);
+
+	lua_State *LU = rt.GetVM(UserVM);
+	lua_State *LA = rt.CreateActor();
+	lua_State *LB = rt.CreateActor();
+
+	CHECK_EQ(hit, 2);
+	REQUIRE_EQ(rt.NumActors(), 2u);
+	CHECK_EQ(rt.GetActor(0), LA);
+	CHECK_EQ(rt.GetActor(1), LB);
+
+	// Separate VMs, so their threads can run concurrently
+	SbxThreadData *udata = luaSBX_getthreaddata(LA);
+	CHECK_EQ(udata->vmType, UserVM);
+	CHECK_EQ(udata->identity, GameScriptIdentity);
+	CHECK_NE(udata->global, luaSBX_getthreaddata(LU)->global);
+	CHECK_NE(udata->global, luaSBX_getthreaddata(LB)->global);
+	CHECK_EQ(udata->global->initTimestamp, luaSBX_getthreaddata(LU)->global->initTimestamp);
+}
+
+TEST_CASE("page bytes") {
+	LuauRuntime plain(nullptr);
+	CHECK_EQ(plain.GetPageBytes(), 0u);
+
+	LuauRuntime rt(nullptr, false, true);
+	size_t pageBytes = rt.GetPageBytes();
+	CHECK_GT(pageBytes, 0u);
+
+	// Actors have slab allocators of their own
+	rt.CreateActor();
+	CHECK_GT(rt.GetPageBytes(), pageBytes);
+}
+
 TEST_SUITE_END();
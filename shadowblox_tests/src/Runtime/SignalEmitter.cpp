@@ -46,7 +46,7 @@ TEST_CASE("immediate") {
 	udata->signalConnections = &connections;
 
 	SUBCASE("basic functionality") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
@@ -70,12 +70,17 @@ TEST_CASE("immediate") {
 		)ASDF")
 
 		CHECK_EVAL_EQ(L, "return conn.Connected", bool, true);
+		CHECK(emitter->HasListeners());
+		CHECK(emitter->HasListeners(SignalEmitter::GetSignalId("TestSignal")));
+		CHECK_FALSE(emitter->HasListeners(SignalEmitter::GetSignalId("OtherSignal")));
 
-		emitter->Emit("TestEmitter", "TestSignal", "abc", 123);
-		emitter->Emit("TestEmitter", "TestSignal", "def", 456);
-		emitter->Emit("TestEmitter", "TestSignal", "ghi", 789);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "abc", 123);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "def", 456);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "ghi", 789);
 
 		CHECK_EVAL_EQ(L, "return conn.Connected", bool, false);
+		CHECK_FALSE(emitter->HasListeners());
+		CHECK_FALSE(emitter->HasListeners(SignalEmitter::GetSignalId("TestSignal")));
 
 		lua_getglobal(L, "hits");
 		CHECK_EQ(lua_tonumber(L, -1), 2);
@@ -95,16 +100,16 @@ TEST_CASE("immediate") {
 	}
 
 	SUBCASE("reentrancy negative") {
-		RBXScriptSignal signal1(emitter, "TestSignal1");
+		RBXScriptSignal signal1(emitter, SignalEmitter::GetSignalId("TestSignal1"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal1);
 		lua_setglobal(L, "signal1");
 
-		RBXScriptSignal signal2(emitter, "TestSignal2");
+		RBXScriptSignal signal2(emitter, SignalEmitter::GetSignalId("TestSignal2"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal2);
 		lua_setglobal(L, "signal2");
 
 		lua_pushcfunction(L, [](lua_State *) -> int {
-			emitter->Emit("TestEmitter", "TestSignal2");
+			emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal2"));
 			return 0; }, "emit2");
 		lua_setglobal(L, "emit2");
 
@@ -122,7 +127,7 @@ TEST_CASE("immediate") {
 			end)
 		)ASDF")
 
-		emitter->Emit("TestEmitter", "TestSignal1");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal1"));
 
 		lua_getglobal(L, "hits2");
 		CHECK_EQ(lua_tonumber(L, -1), 8);
@@ -130,12 +135,12 @@ TEST_CASE("immediate") {
 	}
 
 	SUBCASE("reentrancy positive") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
 		lua_pushcfunction(L, [](lua_State *) -> int {
-			emitter->Emit("TestEmitter", "TestSignal");
+			emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
 			return 0; }, "emit");
 		lua_setglobal(L, "emit");
 
@@ -148,13 +153,58 @@ TEST_CASE("immediate") {
 			end)
 		)ASDF")
 
-		emitter->Emit("TestEmitter", "TestSignal");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
 
 		lua_getglobal(L, "hits");
 		CHECK_EQ(lua_tonumber(L, -1), 6);
 		lua_pop(L, 1);
 	}
 
+	SUBCASE("mutation during emit") {
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
+		LuauStackOp<RBXScriptSignal>::Push(L, signal);
+		lua_setglobal(L, "signal");
+
+		CHECK_EVAL_OK(L, R"ASDF(
+			hits1 = 0
+			hits2 = 0
+			hits3 = 0
+			conn2 = nil
+
+			signal:Connect(function()
+				hits1 += 1
+				if conn2 then
+					conn2:Disconnect()
+					conn2 = nil
+				end
+
+				signal:Connect(function()
+					hits3 += 1
+				end)
+			end)
+
+			conn2 = signal:Connect(function()
+				hits2 += 1
+			end)
+		)ASDF")
+
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
+
+		lua_getglobal(L, "hits1");
+		CHECK_EQ(lua_tonumber(L, -1), 1);
+		lua_pop(L, 1);
+
+		lua_getglobal(L, "hits2");
+		CHECK_EQ(lua_tonumber(L, -1), 0);
+		lua_pop(L, 1);
+
+		lua_getglobal(L, "hits3");
+		CHECK_EQ(lua_tonumber(L, -1), 0);
+		lua_pop(L, 1);
+
+		CHECK_EQ(emitter->NumConnections(), 2);
+	}
+
 	luaSBX_close(L);
 	CHECK_EQ(emitter->NumConnections(), 0);
 	emitter = nullptr;
@@ -176,7 +226,7 @@ TEST_CASE("deferred") {
 	udata->signalConnections = &connections;
 
 	SUBCASE("basic functionality") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
@@ -201,10 +251,10 @@ TEST_CASE("deferred") {
 
 		CHECK_EVAL_EQ(L, "return conn.Connected", bool, true);
 
-		emitter->Emit("TestEmitter", "TestSignal", "abc", 123);
-		emitter->Emit("TestEmitter", "TestSignal", "def", 456);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "abc", 123);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "def", 456);
 		// This resumption should be queued but canceled by Disconnect
-		emitter->Emit("TestEmitter", "TestSignal", "ghi", 789);
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "ghi", 789);
 
 		CHECK_EQ(scheduler.NumPendingEvents(), 4);
 
@@ -242,16 +292,16 @@ TEST_CASE("deferred") {
 	}
 
 	SUBCASE("reentrancy negative") {
-		RBXScriptSignal signal1(emitter, "TestSignal1");
+		RBXScriptSignal signal1(emitter, SignalEmitter::GetSignalId("TestSignal1"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal1);
 		lua_setglobal(L, "signal1");
 
-		RBXScriptSignal signal2(emitter, "TestSignal2");
+		RBXScriptSignal signal2(emitter, SignalEmitter::GetSignalId("TestSignal2"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal2);
 		lua_setglobal(L, "signal2");
 
 		lua_pushcfunction(L, [](lua_State *) -> int {
-		emitter->Emit("TestEmitter", "TestSignal2");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal2"));
 		return 0; }, "emit2");
 		lua_setglobal(L, "emit2");
 
@@ -270,7 +320,7 @@ TEST_CASE("deferred") {
 		)ASDF")
 
 		for (int i = 0; i < 16; i++) {
-			emitter->Emit("TestEmitter", "TestSignal1");
+			emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal1"));
 		}
 
 		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 1.0, 1.0);
@@ -285,12 +335,12 @@ TEST_CASE("deferred") {
 	}
 
 	SUBCASE("reentrancy positive") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
 		lua_pushcfunction(L, [](lua_State *) -> int {
-		emitter->Emit("TestEmitter", "TestSignal");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
 		return 0; }, "emit");
 		lua_setglobal(L, "emit");
 
@@ -303,7 +353,7 @@ TEST_CASE("deferred") {
 			end)
 		)ASDF")
 
-		emitter->Emit("TestEmitter", "TestSignal");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
 
 		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 1.0, 1.0);
 
@@ -317,7 +367,7 @@ TEST_CASE("deferred") {
 	}
 
 	SUBCASE("after emitter free") {
-		LuauStackOp<RBXScriptSignal>::Push(L, RBXScriptSignal(emitter, "TestSignal"));
+		LuauStackOp<RBXScriptSignal>::Push(L, RBXScriptSignal(emitter, SignalEmitter::GetSignalId("TestSignal")));
 		lua_setglobal(L, "signal");
 
 		CHECK_EVAL_OK(L, R"ASDF(
@@ -332,7 +382,7 @@ TEST_CASE("deferred") {
 		lua_setglobal(L, "signal");
 		lua_gc(L, LUA_GCCOLLECT, 0);
 
-		emitter->Emit("TestEmitter", "TestSignal");
+		emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"));
 
 		lua_getglobal(L, "hits");
 		CHECK_EQ(lua_tonumber(L, -1), 0);
@@ -366,7 +416,7 @@ TEST_CASE("wait") {
 	udata->global->logger = &logger;
 	udata->signalConnections = &connections;
 
-	RBXScriptSignal signal(emitter, "TestSignal");
+	RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 	LuauStackOp<RBXScriptSignal>::Push(L, signal);
 	lua_setglobal(L, "signal");
 
@@ -376,7 +426,7 @@ TEST_CASE("wait") {
 	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 1.0, 1.0);
 	REQUIRE_EQ(lua_status(L), LUA_YIELD);
 
-	emitter->Emit("TestEmitter", "TestSignal", "abc", 123);
+	emitter->Emit("TestEmitter", SignalEmitter::GetSignalId("TestSignal"), "abc", 123);
 	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 1.0, 1.0);
 	REQUIRE_EQ(lua_status(L), LUA_OK);
 
@@ -399,7 +449,7 @@ TEST_CASE("Luau API") {
 	udata->signalConnections = &connections;
 
 	SUBCASE("signal equality") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal1");
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
@@ -410,7 +460,7 @@ TEST_CASE("Luau API") {
 	}
 
 	SUBCASE("signal tostring") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
@@ -418,7 +468,7 @@ TEST_CASE("Luau API") {
 	}
 
 	SUBCASE("connection tostring") {
-		RBXScriptSignal signal(emitter, "TestSignal");
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"));
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
@@ -426,7 +476,7 @@ TEST_CASE("Luau API") {
 	}
 
 	SUBCASE("Connect security") {
-		RBXScriptSignal signal(emitter, "TestSignal", NotAccessibleSecurity);
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"), NotAccessibleSecurity);
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
@@ -434,7 +484,7 @@ TEST_CASE("Luau API") {
 	}
 
 	SUBCASE("Once security") {
-		RBXScriptSignal signal(emitter, "TestSignal", NotAccessibleSecurity);
+		RBXScriptSignal signal(emitter, SignalEmitter::GetSignalId("TestSignal"), NotAccessibleSecurity);
 		LuauStackOp<RBXScriptSignal>::Push(L, signal);
 		lua_setglobal(L, "signal");
 
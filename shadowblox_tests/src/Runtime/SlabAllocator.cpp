@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "lua.h"
+
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/SlabAllocator.hpp"
+#include "Utils.hpp"
+
+using namespace SBX;
+
+TEST_SUITE_BEGIN("Runtime/SlabAllocator");
+
+TEST_CASE("allocation") {
+	SlabAllocator allocator;
+	const SlabStats &stats = allocator.GetStats();
+
+	SUBCASE("free list") {
+		void *a = allocator.Allocate(24);
+		CHECK_EQ(stats.liveBytes[1], 24);
+		CHECK_EQ(stats.liveBlocks[1], 1);
+		CHECK_EQ(stats.pageBytes, SLAB_PAGE_SIZE);
+
+		allocator.Free(a, 24);
+		CHECK_EQ(stats.liveBytes[1], 0);
+		CHECK_EQ(stats.liveBlocks[1], 0);
+
+		// Freed blocks are reused first
+		CHECK_EQ(allocator.Allocate(32), a);
+	}
+
+	SUBCASE("reallocate") {
+		char *a = static_cast<char *>(allocator.Allocate(8));
+		memcpy(a, "abcdefg", 8);
+
+		// Same size class
+		CHECK_EQ(allocator.Reallocate(a, 8, 16), a);
+		CHECK_EQ(stats.liveBytes[0], 16);
+
+		char *b = static_cast<char *>(allocator.Reallocate(a, 16, 100));
+		CHECK_NE(b, a);
+		CHECK_EQ(strcmp(b, "abcdefg"), 0);
+		CHECK_EQ(stats.liveBytes[0], 0);
+		CHECK_EQ(stats.liveBytes[6], 100);
+
+		// Large allocations go to the system allocator
+		char *c = static_cast<char *>(allocator.Reallocate(b, 100, 4096));
+		CHECK_EQ(strcmp(c, "abcdefg"), 0);
+		CHECK_EQ(stats.liveBytes[6], 0);
+		CHECK_EQ(stats.largeBytes, 4096);
+		CHECK_EQ(allocator.GetLiveBytes(), 4096);
+
+		allocator.Free(c, 4096);
+		CHECK_EQ(allocator.GetLiveBytes(), 0);
+	}
+}
+
+TEST_CASE("VM") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity, true);
+	SlabAllocator *allocator = luaSBX_getthreaddata(L)->global->allocator;
+	REQUIRE_NE(allocator, nullptr);
+
+	size_t before = allocator->GetLiveBytes();
+	CHECK_GT(before, 0);
+
+	CHECK_EVAL_OK(L, R"ASDF(
+		values = {}
+		for i = 1, 1000 do
+			values[i] = { i, tostring(i) }
+		end
+	)ASDF")
+
+	CHECK_GT(allocator->GetLiveBytes(), before);
+
+	// Pages are kept once freed
+	size_t pageBytes = allocator->GetStats().pageBytes;
+	CHECK_EVAL_OK(L, "values = nil");
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	CHECK_LT(allocator->GetLiveBytes(), allocator->GetStats().pageBytes);
+	CHECK_EQ(allocator->GetStats().pageBytes, pageBytes);
+
+	luaSBX_close(L);
+}
+
+TEST_SUITE_END();
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "lua.h"
@@ -89,6 +90,8 @@ TEST_CASE("basic") {
 	testStackOp<bool>(L, true);
 	testStackOp<int>(L, 12);
 	testStackOp<std::string>(L, "hello there! おはようございます");
+	testStackOp<std::string>(L, std::string("embedded\0null", 13));
+	testStackOp<std::string_view>(L, std::string_view("embedded\0null", 13));
 
 	luaSBX_close(L);
 }
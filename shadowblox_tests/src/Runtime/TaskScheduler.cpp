@@ -14,10 +14,20 @@
 
 #include "doctest.h"
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "lua.h"
 
 #include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/LuauRuntime.hpp"
+#include "Sbx/Runtime/SignalEmitter.hpp"
 #include "Sbx/Runtime/TaskScheduler.hpp"
+#include "Sbx/Runtime/ThreadPool.hpp"
 #include "Utils.hpp"
 
 using namespace SBX;
@@ -68,6 +78,179 @@ TEST_CASE("VM closed") {
 	CHECK_EQ(scheduler.NumPendingTasks(), 0);
 }
 
+TEST_CASE("timers") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	udata->global->scheduler = &scheduler;
+
+	lua_State *T1 = luaSBX_newthread(L, ElevatedGameScriptIdentity);
+	lua_State *T2 = luaSBX_newthread(L, ElevatedGameScriptIdentity);
+
+	CHECK_EVAL_OK(T1, "assert(task.wait(2) >= 2)");
+	CHECK_EVAL_OK(T2, "assert(task.wait(1) >= 1)");
+	REQUIRE_EQ(scheduler.NumPendingTasks(), 2);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 1.5, 1.0);
+	CHECK_EQ(lua_status(T1), LUA_YIELD);
+	CHECK_EQ(lua_status(T2), LUA_OK);
+	CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 2, 1.0, 1.0);
+	CHECK_EQ(lua_status(T1), LUA_OK);
+	CHECK_EQ(scheduler.NumPendingTasks(), 0);
+
+	lua_pop(L, 2); // threads
+	luaSBX_close(L);
+}
+
+TEST_CASE("budget") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	udata->global->scheduler = &scheduler;
+
+	scheduler.SetBudget(ResumptionPoint::Heartbeat, 1);
+	CHECK_EQ(scheduler.GetBudget(ResumptionPoint::Heartbeat), 1);
+	CHECK_EQ(scheduler.GetBudget(ResumptionPoint::Wait), 0);
+
+	lua_State *T1 = luaSBX_newthread(L, ElevatedGameScriptIdentity);
+	lua_State *T2 = luaSBX_newthread(L, ElevatedGameScriptIdentity);
+
+	auto usage = std::make_shared<SbxCpuUsage>();
+	luaSBX_setcpuusage(T1, usage);
+
+	const char *src = R"ASDF(
+		task.wait(1)
+		local x = 0
+		for i = 1, 100000 do
+			x += i
+		end
+	)ASDF";
+
+	CHECK_EVAL_OK(T1, src);
+	CHECK_EVAL_OK(T2, src);
+	REQUIRE_EQ(scheduler.NumPendingTasks(), 2);
+
+	// The first task always runs and exhausts the budget
+	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 2.0, 1.0);
+	CHECK_EQ(lua_status(T1), LUA_OK);
+	CHECK_EQ(lua_status(T2), LUA_YIELD);
+	CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 2, 0.0, 1.0);
+	CHECK_EQ(lua_status(T2), LUA_OK);
+	CHECK_EQ(scheduler.NumPendingTasks(), 0);
+
+	// Time is charged to each thread, and to the usage shared with T1
+	CHECK_GT(luaSBX_getthreaddata(T1)->cpuTime, 0.0);
+	CHECK_GT(luaSBX_getthreaddata(T2)->cpuTime, 0.0);
+	CHECK_EQ(usage->time.load(), luaSBX_getthreaddata(T1)->cpuTime);
+	CHECK_EQ(usage->resumptions.load(), 2);
+
+	lua_pop(L, 2); // threads
+	luaSBX_close(L);
+}
+
+TEST_CASE("cancel while resuming") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	udata->global->scheduler = &scheduler;
+
+	scheduler.SetBudget(ResumptionPoint::Heartbeat, 1);
+
+	// The first task cancels the next one in the queue, and the last one
+	// spills over to the next call
+	CHECK_EVAL_OK(L, R"ASDF(
+		order = {}
+		local b
+
+		task.defer(function()
+			local x = 0
+			for i = 1, 100000 do
+				x += i
+			end
+
+			table.insert(order, "a")
+			task.cancel(b)
+		end)
+
+		b = task.defer(function()
+			table.insert(order, "b")
+		end)
+
+		task.defer(function()
+			table.insert(order, "c")
+		end)
+	)ASDF")
+
+	REQUIRE_EQ(scheduler.NumPendingTasks(), 3);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+	CHECK_EQ(scheduler.NumPendingTasks(), 1);
+	CHECK_EVAL_OK(L, "assert(table.concat(order, \",\") == \"a\")")
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 2, 0.0, 1.0);
+	CHECK_EQ(scheduler.NumPendingTasks(), 0);
+	CHECK_EVAL_OK(L, "assert(table.concat(order, \",\") == \"a,c\")")
+
+	luaSBX_close(L);
+}
+
+TEST_CASE("GC pacing") {
+	LuauRuntime rt(nullptr);
+	TaskScheduler scheduler(&rt);
+
+	SUBCASE("unlimited") {
+		scheduler.SetGCBudget(0);
+		scheduler.GCStep(1.0);
+
+		for (int i = 0; i < VMMax; i++) {
+			CHECK_EQ(scheduler.GetGCStepSize(i), (uint32_t)GC_RATE_MIN);
+		}
+	}
+
+	SUBCASE("budget") {
+		// Before any measurement, cost is predicted at GC_COST_INITIAL
+		scheduler.SetGCBudget(10);
+		scheduler.GCStep(1.0);
+
+		for (int i = 0; i < VMMax; i++) {
+			CHECK_LE(scheduler.GetGCStepSize(i), 10u);
+		}
+
+		// Spare frame time goes to collection carried over from before
+		scheduler.SetGCBudget(1);
+		scheduler.GCStep(1e-3, 1.0);
+
+		for (int i = 0; i < VMMax; i++) {
+			CHECK_GT(scheduler.GetGCStepSize(i), 1u);
+		}
+	}
+
+	SUBCASE("actors") {
+		scheduler.SetGCBudget(0);
+		CHECK_EQ(scheduler.NumGCPacedVMs(), (size_t)VMMax);
+
+		rt.CreateActor();
+		rt.CreateActor();
+		scheduler.GCStep(1.0);
+
+		REQUIRE_EQ(scheduler.NumGCPacedVMs(), (size_t)VMMax + 2);
+		for (size_t i = VMMax; i < scheduler.NumGCPacedVMs(); i++) {
+			CHECK_EQ(scheduler.GetGCStepSize(i), (uint32_t)GC_RATE_MIN);
+		}
+
+		// Starts over with the next runtime
+		scheduler.SetRuntime(&rt);
+		CHECK_EQ(scheduler.NumGCPacedVMs(), (size_t)VMMax);
+	}
+}
+
 TEST_CASE("wait") {
 	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
 	TaskScheduler scheduler(nullptr);
@@ -125,4 +308,321 @@ TEST_CASE("wait") {
 	luaSBX_close(L);
 }
 
+TEST_CASE("task library") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+
+	SbxThreadData *udata = luaSBX_getthreaddata(L);
+	udata->global->scheduler = &scheduler;
+
+	SUBCASE("spawn") {
+		CHECK_EVAL_OK(L, R"ASDF(
+			order = {}
+			local t = task.spawn(function(value)
+				table.insert(order, value)
+				task.wait(1)
+				table.insert(order, "resumed")
+			end, "spawned")
+
+			table.insert(order, "after")
+			assert(type(t) == "thread")
+		)ASDF")
+
+		REQUIRE_EQ(lua_status(L), LUA_OK);
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 2.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_EVAL_OK(L, R"ASDF(
+			assert(table.concat(order, ",") == "spawned,after,resumed")
+		)ASDF")
+	}
+
+	SUBCASE("defer") {
+		CHECK_EVAL_OK(L, R"ASDF(
+			deferred = nil
+			task.defer(function(a, b)
+				deferred = a + b
+			end, 1, 2)
+
+			assert(deferred == nil)
+		)ASDF")
+
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_EVAL_OK(L, "assert(deferred == 3)")
+	}
+
+	SUBCASE("delay") {
+		CHECK_EVAL_OK(L, R"ASDF(
+			delayed = nil
+			task.delay(1, function(value)
+				delayed = value
+			end, "done")
+		)ASDF")
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.5, 1.0);
+		CHECK_EVAL_OK(L, "assert(delayed == nil)")
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 2, 0.6, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_EVAL_OK(L, "assert(delayed == \"done\")")
+	}
+
+	SUBCASE("cancel") {
+		CHECK_EVAL_OK(L, R"ASDF(
+			resumed = false
+			local t = task.delay(1, function()
+				resumed = true
+			end)
+
+			task.cancel(t)
+		)ASDF")
+
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 2.0, 1.0);
+		CHECK_EVAL_OK(L, "assert(not resumed)")
+	}
+
+	SUBCASE("reschedule") {
+		// Only the latest schedule of a yielded thread applies
+		CHECK_EVAL_OK(L, R"ASDF(
+			hits = 0
+			local t = task.spawn(function()
+				task.wait(1)
+				hits += 1
+			end)
+
+			task.defer(t)
+		)ASDF")
+
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 2.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_EVAL_OK(L, "assert(hits == 1)")
+	}
+
+	SUBCASE("desynchronize") {
+		CHECK_EVAL_OK(L, R"ASDF(
+			order = {}
+			task.spawn(function()
+				task.desynchronize()
+				table.insert(order, "parallel")
+				task.synchronize()
+				table.insert(order, "serial")
+			end)
+		)ASDF")
+
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+		// Runs in the parallel phase, then waits for the next serial one
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+		CHECK_EVAL_OK(L, "assert(table.concat(order, \",\") == \"parallel\")")
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 2, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_EVAL_OK(L, "assert(table.concat(order, \",\") == \"parallel,serial\")")
+	}
+
+	luaSBX_close(L);
+}
+
+TEST_CASE("parallel phase") {
+	ThreadPool pool(1);
+	TaskScheduler scheduler(nullptr);
+	scheduler.SetThreadPool(&pool);
+
+	std::array<lua_State *, 2> vms = {
+		luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity),
+		luaSBX_newstate(UserVM, GameScriptIdentity),
+	};
+
+	for (lua_State *L : vms) {
+		luaSBX_getthreaddata(L)->global->scheduler = &scheduler;
+
+		CHECK_EVAL_OK(L, R"ASDF(
+			count = 0
+			for i = 1, 3 do
+				task.spawn(function()
+					task.desynchronize()
+					count += 1
+				end)
+			end
+		)ASDF")
+	}
+
+	CHECK_EQ(scheduler.NumPendingTasks(), 6);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+	CHECK_EQ(scheduler.NumPendingTasks(), 0);
+
+	for (lua_State *L : vms) {
+		CHECK_EVAL_OK(L, "assert(count == 3)");
+		luaSBX_close(L);
+	}
+}
+
+static std::atomic<int> serialCalls = 0;
+
+static int DeferSerial(lua_State * /*L*/) {
+	TaskScheduler *scheduler = TaskScheduler::GetParallelScheduler();
+	if (scheduler) {
+		scheduler->DeferSerial([]() {
+			// Run once the workers are done
+			CHECK_EQ(TaskScheduler::GetParallelScheduler(), nullptr);
+			serialCalls++;
+		});
+	}
+
+	return 0;
+}
+
+TEST_CASE("deferred serial") {
+	ThreadPool pool(1);
+	TaskScheduler scheduler(nullptr);
+	scheduler.SetThreadPool(&pool);
+	serialCalls = 0;
+
+	lua_State *L = luaSBX_newstate(UserVM, GameScriptIdentity);
+	luaSBX_getthreaddata(L)->global->scheduler = &scheduler;
+
+	lua_pushcfunction(L, DeferSerial, "deferSerial");
+	lua_setglobal(L, "deferSerial");
+
+	CHECK_EVAL_OK(L, R"ASDF(
+		deferSerial()
+		task.spawn(function()
+			task.desynchronize()
+			deferSerial()
+			deferSerial()
+		end)
+	)ASDF")
+
+	// Not in the parallel phase
+	CHECK_EQ(serialCalls, 0);
+
+	scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+	CHECK_EQ(serialCalls, 2);
+
+	luaSBX_close(L);
+}
+
+TEST_CASE("deferred callback") {
+	int calls = 0;
+
+	SUBCASE("inline") {
+		DeferredCallback cb([&calls]() { calls++; });
+		DeferredCallback moved = std::move(cb);
+		CHECK_FALSE(static_cast<bool>(cb));
+		REQUIRE(static_cast<bool>(moved));
+
+		moved();
+		CHECK_EQ(calls, 1);
+	}
+
+	SUBCASE("heap") {
+		std::array<char, DeferredCallback::INLINE_SIZE * 2> big{};
+		big[0] = 1;
+
+		DeferredCallback cb([&calls, big]() { calls += big[0]; });
+		DeferredCallback moved = std::move(cb);
+		CHECK_FALSE(static_cast<bool>(cb));
+		REQUIRE(static_cast<bool>(moved));
+
+		moved();
+		CHECK_EQ(calls, 1);
+	}
+}
+
+TEST_CASE("deferred events") {
+	lua_State *L = luaSBX_newstate(CoreVM, ElevatedGameScriptIdentity);
+	TaskScheduler scheduler(nullptr);
+	SignalEmitter emitter;
+
+	std::vector<int> order;
+
+	SUBCASE("ring growth") {
+		// Events queued while draining wrap around the ring as it grows
+		for (int i = 0; i < 10; i++) {
+			scheduler.AddDeferredEvent(&emitter, i, L, [&, i]() {
+				order.push_back(i);
+
+				if (i == 0) {
+					for (int j = 10; j < 50; j++) {
+						scheduler.AddDeferredEvent(&emitter, j, L, [&, j]() { order.push_back(j); });
+					}
+				}
+			});
+		}
+
+		CHECK_EQ(scheduler.NumPendingEvents(), 10);
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingEvents(), 0);
+
+		REQUIRE_EQ(order.size(), 50u);
+		for (int i = 0; i < 50; i++) {
+			CHECK_EQ(order[i], i);
+		}
+	}
+
+	SUBCASE("reentrancy limit") {
+		bool rejected = false;
+
+		std::function<void()> fire = [&]() {
+			bool created = scheduler.AddDeferredEvent(&emitter, 1, L, [&]() {
+				order.push_back(1);
+				fire();
+			});
+
+			if (!created) {
+				rejected = true;
+
+				// Other events are counted separately
+				CHECK(scheduler.AddDeferredEvent(&emitter, 2, L, [&]() { order.push_back(2); }));
+			}
+		};
+
+		fire();
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+
+		CHECK(rejected);
+		REQUIRE_EQ(order.size(), DEFERRED_EVENT_REENTRANCY_LIMIT + 1u);
+		CHECK_EQ(order.back(), 2);
+
+		// The chain starts over in the next resumption
+		order.clear();
+		rejected = false;
+		fire();
+		scheduler.Resume(ResumptionPoint::Heartbeat, 2, 0.0, 1.0);
+		CHECK_EQ(order.size(), DEFERRED_EVENT_REENTRANCY_LIMIT + 1u);
+	}
+
+	SUBCASE("cancel queued") {
+		scheduler.AddDeferredEvent(&emitter, 1, L, [&]() { order.push_back(1); });
+		scheduler.AddDeferredEvent(&emitter, 2, L, [&]() {
+			order.push_back(2);
+
+			// Also cancels events which are queued behind the running one
+			scheduler.CancelEvents(&emitter, 3);
+		});
+		scheduler.AddDeferredEvent(&emitter, 1, L, [&]() { order.push_back(1); });
+		scheduler.AddDeferredEvent(&emitter, 3, L, [&]() { order.push_back(3); });
+		scheduler.AddDeferredEvent(&emitter, 4, L, [&]() { order.push_back(4); });
+
+		scheduler.CancelEvents(&emitter, 1);
+		CHECK_EQ(scheduler.NumPendingEvents(), 3);
+
+		scheduler.Resume(ResumptionPoint::Heartbeat, 1, 0.0, 1.0);
+		CHECK_EQ(scheduler.NumPendingEvents(), 0);
+		CHECK_EQ(order, std::vector<int>{ 2, 4 });
+	}
+
+	luaSBX_close(L);
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MPL-2.0
+/*******************************************************************************
+ * shadowblox - https://git.seki.pw/Fumohouse/shadowblox
+ *
+ * Copyright 2025-present ksk.
+ * Copyright 2025-present shadowblox contributors.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License,
+ * v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ * obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * See COPYRIGHT.txt for more details.
+ ******************************************************************************/
+
+#include "doctest.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "lua.h"
+
+#include "Sbx/Classes/ClassDB.hpp"
+#include "Sbx/Classes/DataModel.hpp"
+#include "Sbx/Classes/RunService.hpp"
+#include "Sbx/GodotBridge.hpp"
+#include "Sbx/Runtime/Base.hpp"
+#include "Sbx/Runtime/LuauRuntime.hpp"
+#include "Sbx/Runtime/TaskScheduler.hpp"
+#include "Sbx/RuntimePool.hpp"
+#include "Utils.hpp"
+
+using namespace SBX;
+
+TEST_SUITE_BEGIN("RuntimePool");
+
+static void InitVM(lua_State *L) {
+	Bridge::RegisterAllClasses(L);
+}
+
+static void WaitReady(const RuntimePool &pool, size_t count) {
+	// The pool is refilled in the background
+	for (int i = 0; i < 1000 && pool.NumReady() < count; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+}
+
+TEST_CASE("runtime pool") {
+	Bridge::InitializeAllClasses();
+
+	RuntimePool pool(2, InitVM);
+	WaitReady(pool, 2);
+	REQUIRE_EQ(pool.NumReady(), 2u);
+
+	SUBCASE("acquire") {
+		std::unique_ptr<PooledRuntime> entry = pool.Acquire();
+		REQUIRE(entry);
+		REQUIRE(entry->runtime);
+		REQUIRE(entry->dataModel);
+
+		// Globals are registered ahead of time
+		lua_State *L = entry->runtime->GetVM(UserVM);
+		lua_getglobal(L, "game");
+		CHECK_EQ(lua_type(L, -1), LUA_TUSERDATA);
+		lua_pop(L, 1);
+
+		// Refilled in the background
+		WaitReady(pool, 2);
+		CHECK_EQ(pool.NumReady(), 2u);
+
+		pool.Release(std::move(entry));
+	}
+
+	SUBCASE("acquire when empty") {
+		std::unique_ptr<PooledRuntime> a = pool.Acquire();
+		std::unique_ptr<PooledRuntime> b = pool.Acquire();
+		std::unique_ptr<PooledRuntime> c = pool.Acquire();
+
+		REQUIRE(c);
+		CHECK_NE(a->runtime.get(), c->runtime.get());
+		CHECK_NE(b->runtime.get(), c->runtime.get());
+		CHECK_NE(a->dataModel, c->dataModel);
+
+		pool.Release(std::move(a));
+		pool.Release(std::move(b));
+		pool.Release(std::move(c));
+	}
+
+	SUBCASE("release") {
+		std::unique_ptr<PooledRuntime> entry = pool.Acquire();
+
+		TaskScheduler scheduler(entry->runtime.get());
+		lua_State *L = entry->runtime->GetVM(UserVM);
+		luaSBX_getthreaddata(L)->global->scheduler = &scheduler;
+		entry->dataModel->GetRunService()->SetScheduler(&scheduler);
+		entry->dataModel->GetRunService()->Run();
+		CHECK_EVAL_OK(L, "game:GetService('RunService').Heartbeat:Connect(function() end)");
+
+		lua_State *T = luaSBX_newthread(L, ElevatedGameScriptIdentity);
+		CHECK_EVAL_OK(T, "task.wait(1)");
+		lua_pop(L, 1); // thread
+		CHECK_EQ(scheduler.NumPendingTasks(), 1);
+
+		std::shared_ptr<Classes::RunService> runService = entry->dataModel->GetRunService();
+		pool.Release(std::move(entry));
+
+		// Detached from the host before being destroyed in the background
+		CHECK_EQ(scheduler.NumPendingTasks(), 0);
+		CHECK_FALSE(runService->IsRunning());
+	}
+
+	SUBCASE("destroy with connections") {
+		std::unique_ptr<PooledRuntime> entry = pool.Acquire();
+		lua_State *L = entry->runtime->GetVM(UserVM);
+		CHECK_EVAL_OK(L, "game:GetService('RunService').Heartbeat:Connect(function() end)");
+
+		std::shared_ptr<Classes::RunService> runService = entry->dataModel->GetRunService();
+		CHECK_EQ(runService->NumConnections(), 1);
+
+		// Outlives the VMs, so must not keep references into them
+		entry.reset();
+		CHECK_EQ(runService->NumConnections(), 0);
+	}
+
+	SUBCASE("scheduler switches runtime") {
+		std::unique_ptr<PooledRuntime> a = pool.Acquire();
+		TaskScheduler scheduler(a->runtime.get());
+		scheduler.GCStep(1.0 / 60.0);
+		pool.Release(std::move(a));
+
+		std::unique_ptr<PooledRuntime> b = pool.Acquire();
+		scheduler.SetRuntime(b->runtime.get());
+		for (int i = 0; i < VMMax; i++) {
+			CHECK_EQ(scheduler.GetGCStepSize(i), 0u);
+		}
+
+		scheduler.GCStep(1.0 / 60.0);
+		pool.Release(std::move(b));
+	}
+}
+
+TEST_CASE("freeze shared state") {
+	Bridge::InitializeAllClasses();
+	CHECK_FALSE(Classes::ClassDB::IsFrozen());
+
+	{
+		// Frozen once the first runtime exists, before any are created in the
+		// background
+		RuntimePool pool(2, InitVM, false, false, true);
+		CHECK(Classes::ClassDB::IsFrozen());
+
+		WaitReady(pool, 2);
+		CHECK_EQ(pool.NumReady(), 2u);
+		CHECK(Classes::ClassDB::IsFrozen());
+	}
+
+	CHECK_FALSE(Classes::ClassDB::IsFrozen());
+}
+
+TEST_SUITE_END();